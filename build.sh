@@ -31,6 +31,9 @@ fi
 $premake gmake
 make -C bin/ config=$makeconfig
 
+# Pre-decode the PNG assets so the screensaver can map them instead of decoding at startup.
+./bin/assetpacker/bin/$platform/$config/assetpacker pack assets assets.pack
+
 if $run; then
 	./bin/$target/bin/$platform/$config/$target
 fi
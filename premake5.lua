@@ -65,7 +65,7 @@ project "screenshaver"
 		defines { "LOGGING_WRITE_TO_FILE" }
 
 	filter "platforms:linux64"
-		links { "SDL3", "m", "stdc++" }
+		links { "SDL3", "m", "stdc++", "X11", "Xext", "Xrandr", "Xdamage", "Xfixes", "Xcomposite" }
 		defines { "PARTICLE_PHYSICS_SOLVER_WORKER_COUNT=8" }
 	
 	filter "platforms:rpi"
@@ -73,9 +73,95 @@ project "screenshaver"
 		defines { "PARTICLE_PHYSICS_SOLVER_WORKER_COUNT=4" }
 
 	filter "platforms:win64"
-		links { "SDL3", "gdi32" }
+		links { "SDL3", "gdi32", "advapi32" }
 		defines { "__WINDOWS__" }
 		defines { "PARTICLE_PHYSICS_SOLVER_WORKER_COUNT=8" }
 
 	filter {"platforms:win64", "configurations:debug"}
 		kind "ConsoleApp"
+
+project "assetpacker"
+	kind "ConsoleApp"
+	language "C"
+	cdialect "gnu23"
+	toolset "gcc"
+	location "bin/assetpacker"
+	files {
+		"tools/assetpacker/**.c",
+		"src/common/AssetPack.c",
+		"src/common/AssetPack.h",
+		"src/common/Log.c",
+		"src/common/Log.h",
+	}
+	includedirs { "src/common" }
+	debugdir "."
+
+	filter "platforms:linux64 or rpi"
+		links { "SDL3", "m" }
+
+	filter "platforms:win64"
+		links { "SDL3" }
+
+project "logdecode"
+	kind "ConsoleApp"
+	language "C"
+	cdialect "gnu23"
+	toolset "gcc"
+	location "bin/logdecode"
+	files {
+		"tools/logdecode/**.c",
+		"src/common/Log.c",
+		"src/common/Log.h",
+	}
+	includedirs { "src/common" }
+	debugdir "."
+
+	filter "platforms:linux64 or rpi"
+		links { "SDL3", "m" }
+
+	filter "platforms:win64"
+		links { "SDL3" }
+
+project "pixelbench"
+	kind "ConsoleApp"
+	language "C"
+	cdialect "gnu23"
+	toolset "gcc"
+	location "bin/pixelbench"
+	files {
+		"tools/pixelbench/**.c",
+		"src/common/LargeAlloc.c",
+		"src/common/LargeAlloc.h",
+		"src/common/Log.c",
+		"src/common/Log.h",
+		"src/common/MemoryTracker.c",
+		"src/common/MemoryTracker.h",
+	}
+	includedirs { "src/common" }
+	debugdir "."
+
+	filter "platforms:linux64 or rpi"
+		links { "SDL3", "m" }
+
+	filter "platforms:win64"
+		links { "SDL3", "advapi32" }
+
+project "pixelconverttest"
+	kind "ConsoleApp"
+	language "C"
+	cdialect "gnu23"
+	toolset "gcc"
+	location "bin/pixelconverttest"
+	files {
+		"tools/pixelconverttest/**.c",
+		"src/common/PixelConvert.c",
+		"src/common/PixelConvert.h",
+	}
+	includedirs { "src/common" }
+	debugdir "."
+
+	filter "platforms:linux64 or rpi"
+		links { "SDL3", "m" }
+
+	filter "platforms:win64"
+		links { "SDL3" }
@@ -4,12 +4,30 @@
 #include <sokol_time.h>
 #include <stb_ds.h>
 #include <stb_image.h>
+#include <stdlib.h>
 
+#include "AssetPack.h"
 #include "Debug.h"
 #include "Display.h"
+#include "FrameStats.h"
+#include "Jobs.h"
+#include "JsonHelpers.h"
+#include "LargeAlloc.h"
 #include "Log.h"
 #include "Math2D.h"
+#include "MemoryTracker.h"
+#include "PatternLibrary.h"
+#include "PixelConvert.h"
 #include "Razor.h"
+#include "ResourceCache.h"
+#include "StartupProfile.h"
+
+// A pattern fill clipped to one razor's lane. Lanes are disjoint, so every fill of a frame can run as its own job.
+typedef struct ShaveLaneFill {
+	const PatternImage* Pattern;
+	SDL_Surface* Surface;
+	int32 Left, Top, Right, Bottom;
+} ShaveLaneFill;
 
 typedef struct ShaverDisplay {
 	Display Display;
@@ -18,23 +36,56 @@ typedef struct ShaverDisplay {
 	SDL_Window* Window;
 	SDL_Renderer* Renderer;
 	SDL_Rect Bounds;
+	SDL_Rect ScreenshotRect; // Region of ShaverApplication::Screenshot covered by this display
 	SDL_Texture* ScreenshotTexture;
-	SDL_Texture* RazorTexture;
+	int32 ScreenshotLevel; // ScreenshotTexture holds ScreenshotRect box filtered down this many times
+	SDL_Texture** RazorTextures; // One per entry in ShaverApplication::RazorConfigs
 	SDL_Texture* ShavedTexture;
 	SDL_Surface* ShavedSurface;
-	RazorState Razor;
+	RazorState* Razors;			 // One per entry in ShaverApplication::RazorConfigs, each owning a disjoint lane
+	ShaveLaneFill* LaneFills;	 // One per razor, what its fill job writes this frame
 	int ActivePattern;
 } ShaverDisplay;
 
+// Durations of each startup phase, captured so activation latency can be broken down in the log.
+typedef struct StartupTimings {
+	uint64 LaunchTicks;
+	uint64 SDLInitTicks;
+	uint64 CaptureTicks;	   // Measured on the worker that ran the capture
+	uint64 RazorConfigTicks; // Measured on the worker that parsed the config
+	SDL_AtomicInt DecodeMicroseconds; // Summed over every image decode job
+	SDL_AtomicInt DecodeCount;
+	uint64 WindowTicks;
+	uint64 CaptureWaitTicks; // Main thread time blocked on the capture after creating windows
+	uint64 RazorWaitTicks;
+	uint64 TextureTicks;
+	bool FirstFramePresented;
+} StartupTimings;
+
 typedef struct ShaverApplication {
 	ShaverDisplay* Displays;
+	SDL_Point DesktopOrigin;
 	SDL_Surface* Screenshot;
 	InterpolatorContext* InterpolatorContext;
-	SDL_Surface** Patterns;
 	int64 NextInterpolatorId;
-	RazorConfig RazorConfig;
+	RazorConfig* RazorConfigs;
+	char** RazorImageIds; // Resource cache asset id of each razor config's image
+	AssetPack* AssetPack; // Pre-decoded images, NULL when no pack was built, everything is decoded then
+	StartupTimings Startup;
+	JobCounter ScreenshotJob;
+	JobCounter RazorJob;
+	JobCounter ShaveJob; // Lane fills of the current frame, joined before the shaved textures are uploaded
+	bool LiveDesktop;
+	const char* StartupProfilePath; // Startup profile mode, write the report here and exit after the first present
+	int64 PatternMemoryBudget; // From config, 0 keeps the default
+	int64 SurfaceMemoryBudget; // From config, 0 keeps the default
+	int64 TextureMemoryBudget; // From config, 0 keeps the default
+	LargeBuffer LiveDesktopScratch; // Conversion buffer when a screenshot texture's format differs from the capture
+	LargeBuffer DownsampleBuffers[2]; // Ping-pong buffers for building screenshot levels
 	bool RequestShutdown;
 	bool EnableDebugDraw;
+	bool EnableFrameStats;
+	bool EnableMemoryStats;
 	bool EnableConfusionPrevention; // When true make it obvious that the screen saver is running so I don't get
 									// confused while deving
 } ShaverApplication;
@@ -51,7 +102,24 @@ static const ApplicationConfig DefaultApplicationConfig = {};
 
 ShaverApplication* ApplicationCreate();
 void ApplicationDestroy(ShaverApplication* App);
+void ApplicationLoadRazorConfigs(ShaverApplication* App, const char* ConfigFileName);
 void ApplicationCreateDisplays(ShaverApplication* App);
+void ApplicationCreateDisplayScreenshots(ShaverApplication* App);
+void ApplicationCreateDisplayRazors(ShaverApplication* App);
+void ApplicationLogStartupTimings(ShaverApplication* App);
+void ApplicationWriteStartupProfile(ShaverApplication* App);
+void ApplicationBeginLiveDesktopMode(ShaverApplication* App);
+void ApplicationUpdateLiveDesktop(ShaverApplication* App);
+SDL_Rect ApplicationGetScreenshotRect(ShaverApplication* App, const SDL_Rect* DisplayBounds, const SDL_Point* Origin);
+SDL_Texture* CreateTextureFromSurfaceRect(SDL_Renderer* Renderer, SDL_Surface* Surface, const SDL_Rect* Rect);
+int32 ApplicationSelectScreenshotLevel(ShaverApplication* App, const ShaverDisplay* Display);
+const uint8* ApplicationDownsampleScreenshot(
+	ShaverApplication* App,
+	const SDL_Rect* Rect,
+	int32 Level,
+	int32* OutPitch);
+void ApplicationCreateScreenshotTexture(ShaverApplication* App, ShaverDisplay* Display);
+void ApplicationShaveLane(ShaverApplication* App, ShaverDisplay* Display, RazorState* Razor, JobCounter* Counter);
 void ApplicationUpdate(ShaverApplication* App, const GameTime* Time);
 void ApplicationRender(ShaverApplication* App);
 bool ApplicationIsRunning(ShaverApplication* App);
@@ -59,17 +127,193 @@ void ApplicationStopRunning(ShaverApplication* App);
 bool ApplicationEventShouldExit(ShaverApplication* App, const SDL_Event* Event);
 void ApplicationDebugKeyDown(ShaverApplication* App, SDL_Scancode scancode);
 
-bool LoadImage(const char* FileName, SDL_Surface** OutSurface);
-bool LoadImageFromMemory(const void* Data, size_t Bytes, SDL_Surface** OutSurface);
+static void CaptureScreenshotJob(void* UserData)
+{
+	ShaverApplication* App = (ShaverApplication*)UserData;
+	MemoryTag PreviousTag = MemoryPushTag(MemoryTag_Screenshot);
+	uint64 StartTicks = stm_now();
+	if (!ApplicationTakeDesktopScreenshot(&App->Screenshot) || App->Screenshot == NULL) {
+		// Everything after startup assumes a screenshot, a blank one still gets shaved.
+		LogWarning("Screenshot: Capture failed, using placeholder screenshot");
+		SDL_DestroySurface(App->Screenshot);
+		App->Screenshot = SDL_CreateSurface(640, 480, SDL_PIXELFORMAT_RGBA32);
+		if (App->Screenshot == NULL) {
+			PanicAndAbort("Screenshot", "Unable to create a placeholder screenshot");
+		}
+		SDL_FillSurfaceRect(App->Screenshot, NULL, SDL_MapSurfaceRGB(App->Screenshot, 64, 128, 255));
+	}
+	MemoryPopTag(PreviousTag);
+	App->Startup.CaptureTicks = stm_since(StartTicks);
+	StartupProfileRecord("capture", StartTicks, StartTicks + App->Startup.CaptureTicks);
+}
+
+// One image decoded on a worker. Descriptors are heap allocated by the submitter and freed by the job itself.
+typedef struct ImageDecodeJob {
+	ShaverApplication* App;
+	const char* Name;
+	char* AssetId;	  // Optional, the result is added to the resource cache under it, owned by the job
+	char* FileName;	  // Optional, tried first, owned by the job
+	const void* Data; // Embedded fallback
+	size_t Bytes;
+	SDL_Surface** OutSurface;
+} ImageDecodeJob;
+
+static void DecodeImageJob(void* UserData)
+{
+	ImageDecodeJob* Job = (ImageDecodeJob*)UserData;
+	uint64 StartTicks = stm_now();
+
+	bool Loaded = (Job->FileName != NULL) && LoadImage(Job->FileName, Job->OutSurface);
+	if (!Loaded && Job->Data != NULL) {
+		Loaded = LoadImageFromMemory(Job->Data, Job->Bytes, Job->OutSurface);
+	}
+
+	if (Loaded && Job->AssetId != NULL) {
+		*Job->OutSurface = ResourceCacheAddSurface(Job->AssetId, *Job->OutSurface);
+	}
+
+	uint64 DecodeTicks = stm_since(StartTicks);
+	StartupProfileRecord("image_decode", StartTicks, StartTicks + DecodeTicks);
+	SDL_AddAtomicInt(&Job->App->Startup.DecodeMicroseconds, (int)stm_us(DecodeTicks));
+	SDL_AddAtomicInt(&Job->App->Startup.DecodeCount, 1);
+
+	if (Loaded) {
+		LogInfo(
+			"Assets: Decoded %s (%dx%d) in %.2f ms on thread %" SDL_PRIu64,
+			Job->FileName ? Job->FileName : Job->Name,
+			(*Job->OutSurface)->w,
+			(*Job->OutSurface)->h,
+			stm_ms(DecodeTicks),
+			SDL_GetCurrentThreadID());
+	} else {
+		LogError("Assets: Unable to decode %s", Job->FileName ? Job->FileName : Job->Name);
+	}
+
+	SDL_free(Job->FileName);
+	SDL_free(Job->AssetId);
+	SDL_free(Job);
+}
+
+static void SubmitImageDecode(
+	ShaverApplication* App,
+	const char* Name,
+	const char* AssetId,
+	const char* FileName,
+	const void* Data,
+	size_t Bytes,
+	SDL_Surface** OutSurface,
+	JobCounter* Counter)
+{
+	ImageDecodeJob* Job = SDL_malloc(sizeof(ImageDecodeJob));
+	*Job = (ImageDecodeJob){
+		.App = App,
+		.Name = Name,
+		.AssetId = AssetId ? SDL_strdup(AssetId) : NULL,
+		.FileName = FileName ? SDL_strdup(FileName) : NULL,
+		.Data = Data,
+		.Bytes = Bytes,
+		.OutSurface = OutSurface,
+	};
+	*OutSurface = NULL;
+	JobsSubmit(DecodeImageJob, Job, Counter);
+}
+
+static void LoadRazorsJob(void* UserData)
+{
+	ShaverApplication* App = (ShaverApplication*)UserData;
+	uint64 StartTicks = stm_now();
+	ApplicationLoadRazorConfigs(App, "config.json");
+	App->Startup.RazorConfigTicks = stm_since(StartTicks);
+	StartupProfileRecord("razor_config", StartTicks, StartTicks + App->Startup.RazorConfigTicks);
+}
+
+// clang-format off
+static const char PatternData00[] = {
+	#embed "pattern_00.png"
+};
+static const char PatternData01[] = {
+	#embed "pattern_01.png"
+};
+static const char PatternData02[] = {
+	#embed "pattern_02.png"
+};
+static const char PatternData03[] = {
+	#embed "pattern_03.png"
+};
+static const char PatternData04[] = {
+	#embed "pattern_04.png"
+};
+static const char PatternData05[] = {
+	#embed "pattern_05.png"
+};
+static const char PatternData06[] = {
+	#embed "pattern_06.png"
+};
+static const char RazorImageData[] = {
+	#embed "razor.png"
+};
+// clang-format on
+
+typedef struct PatternData {
+	const char* Name;
+	const char* Data;
+	size_t Size;
+} PatternData;
+
+// clang-format off
+#define PATTERN_DATA_ENTRY(Data, Name) (PatternData) { Name, Data, sizeof(Data) }
+// clang-format on
+
+static const PatternData PatternImagesData[] = {
+	PATTERN_DATA_ENTRY(PatternData04, "pattern_04.png"),
+	PATTERN_DATA_ENTRY(PatternData00, "pattern_00.png"),
+	PATTERN_DATA_ENTRY(PatternData02, "pattern_02.png"),
+	PATTERN_DATA_ENTRY(PatternData05, "pattern_05.png"),
+	PATTERN_DATA_ENTRY(PatternData01, "pattern_01.png"),
+	PATTERN_DATA_ENTRY(PatternData03, "pattern_03.png"),
+	PATTERN_DATA_ENTRY(PatternData06, "pattern_06.png"),
+};
+
+#undef PATTERN_DATA_ENTRY
+
+// Patterns dropped in here are added next to the built in ones, and picked up while running.
+#define PATTERN_DIRECTORY "patterns"
+// Default budget for decoded patterns, overridden by "pattern_budget_mb" in config.json.
+#define PATTERN_DEFAULT_MEMORY_BUDGET (16 * 1024 * 1024)
+// Default resource cache budgets, overridden by "surface_budget_mb" and "texture_budget_mb" in config.json.
+#define RESOURCE_DEFAULT_SURFACE_BUDGET (64 * 1024 * 1024)
+#define RESOURCE_DEFAULT_TEXTURE_BUDGET (256 * 1024 * 1024)
+
+static void AddPatterns(const AssetPack* Pack)
+{
+	for (int PatternIndex = 0; PatternIndex < SDL_arraysize(PatternImagesData); PatternIndex++) {
+		const PatternData* Pattern = &PatternImagesData[PatternIndex];
+		SDL_Surface* Packed = AssetPackCreateSurface(Pack, Pattern->Name);
+		if (Packed != NULL) {
+			PatternLibraryAddSurface(Pattern->Name, Packed);
+		} else {
+			PatternLibraryAdd(Pattern->Name, Pattern->Data, Pattern->Size);
+		}
+	}
+}
 
 Application* ApplicationInitialize(const ApplicationConfig* Config)
 {
 	Config = (Config != NULL) ? Config : &DefaultApplicationConfig;
 
+	// Before anything gets a chance to allocate through SDL.
+	MemoryTrackerInitialize();
+
+	stm_setup();
+	uint64 LaunchTicks = stm_now();
+	StartupProfileInitialize(LaunchTicks);
+
+	StartupProfileBegin("sdl_init");
 	if (!SDL_Init(SDL_INIT_VIDEO)) {
 		PanicAndAbort("SDL Error", SDL_GetError());
 	}
 	SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
+	StartupProfileEnd();
 
 	LoggingInitialize(LogLevel_Info);
 	LogInfo(
@@ -80,103 +324,113 @@ Application* ApplicationInitialize(const ApplicationConfig* Config)
 		SDL_VERSIONNUM_MAJOR(SDL_VERSION),
 		SDL_VERSIONNUM_MINOR(SDL_VERSION),
 		SDL_VERSIONNUM_MICRO(SDL_VERSION));
-
-	stm_setup();
+	LargeAllocInitialize();
 
 	ShaverApplication* App = ApplicationCreate();
-	App->InterpolatorContext = CreateInterpolatorContext();
-	ApplicationTakeDesktopScreenshot(&App->Screenshot);
+	App->Startup.LaunchTicks = LaunchTicks;
+	App->Startup.SDLInitTicks = stm_since(LaunchTicks);
+	App->LiveDesktop = Config->LiveDesktop;
+	App->StartupProfilePath = Config->StartupProfilePath;
 
-	App->RazorConfig.InterpolatorContext = App->InterpolatorContext;
-	InitializeRazors((Application*)App, &App->RazorConfig);
+	StartupProfileBegin("jobs_init");
+	JobsInitialize(0);
+	StartupProfileEnd();
 
-	{
-		// clang-format off
-		static const char RazorImageData[] = {
-			#embed "razor.png"
-		};
-		// clang-format on
-		LoadImageFromMemory(RazorImageData, sizeof(RazorImageData), &App->RazorConfig.Image);
-		App->RazorConfig.BladeBounds = (SDL_Rect){0, 0, 128, 32};
-	}
+	// Mapping is cheap, only the pages actually used get read. Must be open before the razor job looks up images.
+	StartupProfileBegin("asset_pack_open");
+	App->AssetPack = AssetPackOpen("assets.pack");
+	StartupProfileEnd();
 
-	{
-		// clang-format off
-		static const char PatternData00[] = {
-			#embed "pattern_00.png"
-		};
-		static const char PatternData01[] = {
-			#embed "pattern_01.png"
-		};
-		static const char PatternData02[] = {
-			#embed "pattern_02.png"
-		};
-		static const char PatternData03[] = {
-			#embed "pattern_03.png"
-		};
-		static const char PatternData04[] = {
-			#embed "pattern_04.png"
-		};
-		static const char PatternData05[] = {
-			#embed "pattern_05.png"
-		};
-		static const char PatternData06[] = {
-			#embed "pattern_06.png"
-		};
-		// clang-format on
-
-		typedef struct PatternData {
-			const char* Data;
-			size_t Size;
-		} PatternData;
-
-		// clang-format off
-#define PATTERN_DATA_ENTRY(Data) (PatternData) { Data, sizeof(Data) }
-		// clang-format on
-
-		const PatternData PatternImagesData[] = {
-			PATTERN_DATA_ENTRY(PatternData04),
-			PATTERN_DATA_ENTRY(PatternData00),
-			PATTERN_DATA_ENTRY(PatternData02),
-			PATTERN_DATA_ENTRY(PatternData05),
-			PATTERN_DATA_ENTRY(PatternData01),
-			PATTERN_DATA_ENTRY(PatternData03),
-			PATTERN_DATA_ENTRY(PatternData06),
-		};
-
-#undef PATTERN_DATA_ENTRY
-
-		for (int PatternIndex = 0; PatternIndex < SDL_arraysize(PatternImagesData); PatternIndex++) {
-			SDL_Surface* PatternSurface;
-			LoadImageFromMemory(
-				PatternImagesData[PatternIndex].Data,
-				PatternImagesData[PatternIndex].Size,
-				&PatternSurface);
-			arrput(App->Patterns, PatternSurface);
-		}
+	StartupProfileBegin("razors_init");
+	App->InterpolatorContext = CreateInterpolatorContext();
+	InitializeRazors((Application*)App);
+	StartupProfileEnd();
+
+	// Capture and decoding run on workers while the main thread creates windows and renderers, which is the other
+	// big chunk of activation time. Every image is its own job so decodes spread over all cores. Built in patterns
+	// aren't decoded here at all, each one is prefetched while the razor that needs it idles.
+	ResourceCacheInitialize(RESOURCE_DEFAULT_SURFACE_BUDGET, RESOURCE_DEFAULT_TEXTURE_BUDGET);
+	JobsSubmit(CaptureScreenshotJob, App, &App->ScreenshotJob);
+	JobsSubmit(LoadRazorsJob, App, &App->RazorJob);
+	StartupProfileBegin("patterns_init");
+	PatternLibraryInitialize(PATTERN_DEFAULT_MEMORY_BUDGET);
+	AddPatterns(App->AssetPack);
+	PatternLibraryWatchDirectory(PATTERN_DIRECTORY);
+	StartupProfileEnd();
+
+	StartupProfileBegin("create_displays");
+	uint64 PhaseStartTicks = stm_now();
+	ApplicationCreateDisplays(App);
+	App->Startup.WindowTicks = stm_since(PhaseStartTicks);
+	StartupProfileEnd();
+
+	StartupProfileBegin("capture_wait");
+	PhaseStartTicks = stm_now();
+	JobsWait(&App->ScreenshotJob);
+	App->Startup.CaptureWaitTicks = stm_since(PhaseStartTicks);
+	StartupProfileEnd();
+
+	StartupProfileBegin("razor_wait");
+	PhaseStartTicks = stm_now();
+	JobsWait(&App->RazorJob);
+	App->Startup.RazorWaitTicks = stm_since(PhaseStartTicks);
+	StartupProfileEnd();
+	if (App->PatternMemoryBudget > 0) {
+		PatternLibrarySetMemoryBudget(App->PatternMemoryBudget);
+	}
+	if (App->SurfaceMemoryBudget > 0 || App->TextureMemoryBudget > 0) {
+		ResourceCacheSetBudget(
+			(App->SurfaceMemoryBudget > 0) ? App->SurfaceMemoryBudget : RESOURCE_DEFAULT_SURFACE_BUDGET,
+			(App->TextureMemoryBudget > 0) ? App->TextureMemoryBudget : RESOURCE_DEFAULT_TEXTURE_BUDGET);
 	}
 
-	ApplicationCreateDisplays(App);
+	PhaseStartTicks = stm_now();
+	StartupProfileBegin("screenshot_textures");
+	ApplicationCreateDisplayScreenshots(App);
+	StartupProfileEnd();
+	StartupProfileBegin("razor_textures");
+	ApplicationCreateDisplayRazors(App);
+	StartupProfileEnd();
+	App->Startup.TextureTicks = stm_since(PhaseStartTicks);
+
+	if (App->LiveDesktop) {
+		StartupProfileBegin("live_desktop_begin");
+		ApplicationBeginLiveDesktopMode(App);
+		StartupProfileEnd();
+	}
 
 #ifdef _DEBUG
 	App->EnableConfusionPrevention = true;
+#endif
+#if DEBUG_OVERLAY
 	App->EnableDebugDraw = true;
 #endif
 
+	StartupProfileBegin("debug_init");
 	DebugInitialize(&(DebugConfig){
 		.CanvasWidth = 800,
 		.CanvasHeight = 600,
 		.BackgroundColor = SDL_MapRGBA(SDL_GetPixelFormatDetails(SDL_PIXELFORMAT_RGBA32), NULL, 32, 32, 32, 196),
 		.ForegroundColor = SDL_MapRGBA(SDL_GetPixelFormatDetails(SDL_PIXELFORMAT_RGBA32), NULL, 200, 255, 255, 255),
 	});
+	StartupProfileEnd();
+
+	ApplicationLogStartupTimings(App);
 
 	return (Application*)App;
 }
 
 void ApplicationShutdown(Application* App)
 {
+	ShaverApplication* ShaverApp = (ShaverApplication*)App;
 	DebugShutdown();
-	ApplicationDestroy((ShaverApplication*)App);
+	PatternLibraryShutdown();
+	JobsShutdown();
+	if (ShaverApp->LiveDesktop) {
+		ApplicationEndLiveDesktop();
+	}
+	ApplicationDestroy(ShaverApp);
+	MemoryTrackerLogSummary();
 	LoggingShutdown();
 	SDL_Quit();
 }
@@ -195,13 +449,14 @@ void ApplicationRun(Application* App)
 
 	while (ApplicationIsRunning(_App)) {
 		uint64 FrameStartTicks = stm_now();
+		MemoryTrackerBeginFrame();
 
 		SDL_Event Event;
 		while (SDL_PollEvent(&Event)) {
 			if (ApplicationEventShouldExit(_App, &Event)) {
 				ApplicationStopRunning(_App);
 			}
-#ifdef _DEBUG
+#if DEBUG_OVERLAY
 			if (Event.type == SDL_EVENT_KEY_DOWN) {
 				ApplicationDebugKeyDown(_App, Event.key.scancode);
 			}
@@ -223,14 +478,23 @@ void ApplicationRun(Application* App)
 		uint64 SimStartTicks = stm_now();
 		ApplicationUpdate(_App, &Time);
 		SimTimeTicks = stm_since(SimStartTicks);
+		FrameStatsAdd(FramePhase_Update, stm_since(FrameStartTicks));
+		if (!_App->Startup.FirstFramePresented) {
+			StartupProfileRecord("first_update", SimStartTicks, SimStartTicks + SimTimeTicks);
+		}
 
 		uint64 RenderStartTicks = stm_now();
 		ApplicationRender(_App);
 		RenderTimeTicks = stm_since(RenderStartTicks);
+		FrameStatsAdd(FramePhase_Render, RenderTimeTicks);
 
+		uint64 WaitStartTicks = stm_now();
 		while (KTargetFramesPerSecond != 0 && stm_sec(stm_since(FrameStartTicks)) < KTargetFrameRateSeconds) {
 			// Do nothing...
 		};
+		FrameStatsAdd(FramePhase_Wait, stm_since(WaitStartTicks));
+		FrameStatsEndFrame();
+		MemoryTrackerEndFrame();
 	}
 }
 
@@ -254,23 +518,154 @@ ShaverApplication* ApplicationCreate()
 
 void ApplicationDestroy(ShaverApplication* App)
 {
-	for (int Index = 0, Count = arrlen(App->Patterns); Index < Count; Index++)
-	{
-		SDL_DestroySurface(App->Patterns[Index]);
+	for (int Index = 0, Count = arrlen(App->RazorConfigs); Index < Count; Index++) {
+		ResourceCacheReleaseSurface(App->RazorConfigs[Index].Image);
+		SDL_free(App->RazorImageIds[Index]);
 	}
-	arrfree(App->Patterns);
-
-	SDL_DestroySurface(App->RazorConfig.Image);
+	arrfree(App->RazorConfigs);
+	arrfree(App->RazorImageIds);
+
+	for (int Index = 0, Count = arrlen(App->Displays); Index < Count; Index++) {
+		ShaverDisplay* Display = &App->Displays[Index];
+		ShaveCoverageShutdown(&Display->Display.Coverage);
+		for (int RazorIndex = 0; RazorIndex < arrlen(Display->RazorTextures); RazorIndex++) {
+			ResourceCacheReleaseTexture(Display->RazorTextures[RazorIndex]);
+		}
+		ResourceCacheReleaseTexture(Display->ScreenshotTexture);
+		ResourceCacheReleaseTexture(Display->ShavedTexture);
+		SDL_DestroySurface(Display->ShavedSurface);
+		arrfree(Display->Razors);
+		arrfree(Display->LaneFills);
+		arrfree(Display->RazorTextures);
+	}
+	ResourceCacheShutdown();
 
 	arrfree(App->Displays);
+	LargeBufferRelease(&App->LiveDesktopScratch);
+	LargeBufferRelease(&App->DownsampleBuffers[0]);
+	LargeBufferRelease(&App->DownsampleBuffers[1]);
+	SDL_DestroySurface(App->Screenshot);
+	AssetPackClose(App->AssetPack); // After every surface viewing it is gone
 	SDL_free(App);
 }
 
+void ApplicationLoadRazorConfigs(ShaverApplication* App, const char* ConfigFileName)
+{
+	static const SDL_Rect DefaultBladeBounds = {0, 0, 128, 32};
+
+	struct json_value_s* ConfigJson = JsonLoadFile(ConfigFileName);
+	struct json_array_s* RazorsJson = NULL;
+	const char** ImagePaths = NULL;
+	if (ConfigJson != NULL) {
+		struct json_value_s* RazorsValue = JsonFindKeyValue(json_value_as_object(ConfigJson), "razors");
+		RazorsJson = (RazorsValue != NULL) ? json_value_as_array(RazorsValue) : NULL;
+	} else {
+		LogWarning("Razors: Unable to load '%s', using default razor", ConfigFileName);
+	}
+
+	// Only read once the config job has joined, the command line can enable it regardless of config.
+	if (ConfigJson != NULL && JsonGetBool(json_value_as_object(ConfigJson), "live_desktop", false)) {
+		App->LiveDesktop = true;
+	}
+	if (ConfigJson != NULL) {
+		struct json_object_s* ConfigObject = json_value_as_object(ConfigJson);
+		App->PatternMemoryBudget = (int64)(JsonGetNumber(ConfigObject, "pattern_budget_mb", 0.0) * 1024.0 * 1024.0);
+		App->SurfaceMemoryBudget = (int64)(JsonGetNumber(ConfigObject, "surface_budget_mb", 0.0) * 1024.0 * 1024.0);
+		App->TextureMemoryBudget = (int64)(JsonGetNumber(ConfigObject, "texture_budget_mb", 0.0) * 1024.0 * 1024.0);
+	}
+
+	for (struct json_array_element_s* Element = (RazorsJson != NULL) ? RazorsJson->start : NULL; Element != NULL;
+		 Element = Element->next)
+	{
+		struct json_object_s* RazorJson = json_value_as_object(Element->value);
+		if (RazorJson == NULL) {
+			continue;
+		}
+
+		RazorConfig Config = {
+			.BladeBounds = DefaultBladeBounds,
+			.InterpolatorContext = App->InterpolatorContext,
+		};
+
+		struct json_string_s* ImagePath = json_value_as_string(JsonFindKeyValue(RazorJson, "image"));
+		arrput(ImagePaths, ImagePath ? ImagePath->string : NULL);
+
+		Rect BladeBounds;
+		if (JsonParseRect(JsonFindKeyValue(RazorJson, "blade_bounds"), &BladeBounds) && BladeBounds.W > 0 &&
+			BladeBounds.H > 0)
+		{
+			Config.BladeBounds = (SDL_Rect){BladeBounds.X, BladeBounds.Y, BladeBounds.W, BladeBounds.H};
+		}
+
+		arrput(App->RazorConfigs, Config);
+	}
+
+	if (arrlen(App->RazorConfigs) == 0) {
+		RazorConfig Config = {
+			.BladeBounds = DefaultBladeBounds,
+			.InterpolatorContext = App->InterpolatorContext,
+		};
+		arrput(App->RazorConfigs, Config);
+		arrput(ImagePaths, NULL);
+	}
+
+	// The config array is final now so decode jobs can hold on to their slots. They count towards this job's counter,
+	// joining it waits for the images as well. Images in the asset pack skip decoding entirely, and an image shared by
+	// several razors is loaded once, the others acquire it from the cache in ApplicationCreateDisplayRazors.
+	for (int RazorIndex = 0; RazorIndex < arrlen(App->RazorConfigs); RazorIndex++) {
+		const char* AssetId = ImagePaths[RazorIndex] ? ImagePaths[RazorIndex] : "razor.png";
+		arrput(App->RazorImageIds, SDL_strdup(AssetId));
+
+		RazorConfig* Config = &App->RazorConfigs[RazorIndex];
+		Config->Image = ResourceCacheAcquireSurface(AssetId);
+		bool Pending = false;
+		for (int Earlier = 0; Earlier < RazorIndex && Config->Image == NULL; Earlier++) {
+			Pending |= SDL_strcmp(App->RazorImageIds[Earlier], AssetId) == 0;
+		}
+		if (Config->Image != NULL || Pending) {
+			continue;
+		}
+
+		SDL_Surface* Packed = AssetPackCreateSurface(App->AssetPack, AssetId);
+		if (Packed != NULL) {
+			Config->Image = ResourceCacheAddSurface(AssetId, Packed);
+			LogInfo("Assets: Mapped %s from asset pack", AssetId);
+			continue;
+		}
+
+		SubmitImageDecode(
+			App,
+			"razor.png",
+			AssetId,
+			ImagePaths[RazorIndex],
+			RazorImageData,
+			sizeof(RazorImageData),
+			&App->RazorConfigs[RazorIndex].Image,
+			&App->RazorJob);
+	}
+	arrfree(ImagePaths);
+
+	LogInfo("Razors: Loaded %d razor config(s)", (int)arrlen(App->RazorConfigs));
+
+	if (ConfigJson != NULL) {
+		free(ConfigJson);
+	}
+}
+
 void ApplicationCreateDisplays(ShaverApplication* App)
 {
 	int DisplayCount = 0;
 	SDL_DisplayID* Displays = SDL_GetDisplays(&DisplayCount);
 
+	// The screenshot covers the whole virtual desktop whose top left corner is the minimum of all display bounds,
+	// this is not necessarily (0, 0) (e.g. monitors left of the primary one on Windows).
+	for (int DisplayIndex = 0; DisplayIndex < DisplayCount; DisplayIndex++) {
+		SDL_Rect Bounds;
+		SDL_GetDisplayBounds(Displays[DisplayIndex], &Bounds);
+		App->DesktopOrigin.x = (DisplayIndex == 0) ? Bounds.x : MIN(App->DesktopOrigin.x, Bounds.x);
+		App->DesktopOrigin.y = (DisplayIndex == 0) ? Bounds.y : MIN(App->DesktopOrigin.y, Bounds.y);
+	}
+
 	for (int DisplayIndex = 0; DisplayIndex < DisplayCount; DisplayIndex++) {
 		SDL_DisplayID DisplayID = Displays[DisplayIndex];
 		const SDL_DisplayMode* DisplayMode = SDL_GetDesktopDisplayMode(DisplayID);
@@ -287,16 +682,32 @@ void ApplicationCreateDisplays(ShaverApplication* App)
 		int Height = DisplayMode->h;
 		SDL_WindowFlags Flags = SDL_WINDOW_TRANSPARENT;
 
+		StartupProfileBegin("display");
+		StartupProfileBegin("window_and_renderer");
 		SDL_CreateWindowAndRenderer(WindowName, Width, Height, Flags, &Window, &Renderer);
+		StartupProfileEnd();
 
+		StartupProfileBegin("fullscreen");
 		SDL_Rect Bounds;
 		SDL_GetDisplayBounds(DisplayID, &Bounds);
 		SDL_SetWindowPosition(Window, Bounds.x, Bounds.y);
 		SDL_SetWindowFullscreen(Window, true);
+		StartupProfileEnd();
 
 		int WindowWidth, WindowHeight;
 		SDL_GetWindowSizeInPixels(Window, &WindowWidth, &WindowHeight);
 
+		StartupProfileBegin("shaved_texture");
+		SDL_Surface* ShavedSurface =
+			CreateLargeSurface(WindowWidth, WindowHeight, SDL_PIXELFORMAT_RGBA32, MemoryTag_ShavedSurface);
+		if (ShavedSurface == NULL) {
+			// Out of blocks or address space for the mapping, the heap only misses out on huge pages.
+			LogWarning("Displays: Unable to map a %dx%d shaved surface, using the heap", WindowWidth, WindowHeight);
+			ShavedSurface = SDL_CreateSurface(WindowWidth, WindowHeight, SDL_PIXELFORMAT_RGBA32);
+			if (ShavedSurface == NULL) {
+				PanicAndAbort("SDL Error", SDL_GetError());
+			}
+		}
 		arrput(
 			App->Displays,
 			((ShaverDisplay){
@@ -310,78 +721,630 @@ void ApplicationCreateDisplays(ShaverApplication* App)
 				.Window = Window,
 				.Renderer = Renderer,
 				.Bounds = Bounds,
-				.ScreenshotTexture = SDL_CreateTextureFromSurface(Renderer, App->Screenshot),
-				.RazorTexture = SDL_CreateTextureFromSurface(Renderer, App->RazorConfig.Image),
-				.ShavedTexture = SDL_CreateTexture(
+				.ShavedTexture = ResourceCacheAddTexture(
 					Renderer,
-					SDL_PIXELFORMAT_RGBA32,
-					SDL_TEXTUREACCESS_STREAMING,
-					WindowWidth,
-					WindowHeight),
-				.ShavedSurface = SDL_CreateSurface(WindowWidth, WindowHeight, SDL_PIXELFORMAT_RGBA32),
+					"shaved",
+					SDL_CreateTexture(
+						Renderer,
+						SDL_PIXELFORMAT_RGBA32,
+						SDL_TEXTUREACCESS_STREAMING,
+						WindowWidth,
+						WindowHeight)),
+				.ShavedSurface = ShavedSurface,
 				.ActivePattern = 1,
 			}));
 
 		ShaverDisplay* NewDisplay = &arrlast(App->Displays);
+		ShaveCoverageInitialize(&NewDisplay->Display.Coverage, WindowWidth, WindowHeight);
+
+		// Later uploads only touch dirty regions so the texture has to start out matching the (empty) surface.
+		SDL_UpdateTexture(
+			NewDisplay->ShavedTexture,
+			NULL,
+			NewDisplay->ShavedSurface->pixels,
+			NewDisplay->ShavedSurface->pitch);
+		StartupProfileEnd();
+		StartupProfileEnd();
+	}
+
+	SDL_free(Displays);
+}
+
+void ApplicationCreateDisplayScreenshots(ShaverApplication* App)
+{
+	ASSERT(JobsIsDone(&App->ScreenshotJob));
 
-		RazorSetPosition(&NewDisplay->Razor, GetRazorCenterDisplayPosition((Display*)NewDisplay, &App->RazorConfig));
-		RazorWait(&NewDisplay->Razor, 1.0f, RazorMoveFinished);
+	for (int DisplayIndex = 0; DisplayIndex < arrlen(App->Displays); DisplayIndex++) {
+		ShaverDisplay* Display = &App->Displays[DisplayIndex];
+		Display->ScreenshotRect = ApplicationGetScreenshotRect(App, &Display->Bounds, &App->DesktopOrigin);
+		ApplicationCreateScreenshotTexture(App, Display);
 	}
 }
 
+void ApplicationCreateDisplayRazors(ShaverApplication* App)
+{
+	ASSERT(JobsIsDone(&App->RazorJob));
+
+	for (int RazorIndex = 0; RazorIndex < arrlen(App->RazorConfigs); RazorIndex++) {
+		RazorConfig* Config = &App->RazorConfigs[RazorIndex];
+		if (Config->Image == NULL) {
+			Config->Image = ResourceCacheAcquireSurface(App->RazorImageIds[RazorIndex]);
+		}
+		if (Config->Image != NULL) {
+			continue;
+		}
+
+		// Neither the configured image nor its fallback decoded, or a bad pack entry was mapped under its name. The
+		// embedded razor stands in under its own id so the texture is found by that.
+		LogError(
+			"Razors: No image for razor %d ('%s'), using the embedded razor",
+			RazorIndex,
+			App->RazorImageIds[RazorIndex]);
+		SDL_free(App->RazorImageIds[RazorIndex]);
+		App->RazorImageIds[RazorIndex] = SDL_strdup("razor.png");
+		Config->Image = ResourceCacheAcquireSurface("razor.png");
+		SDL_Surface* Embedded = NULL;
+		if (Config->Image == NULL && LoadImageFromMemory(RazorImageData, sizeof(RazorImageData), &Embedded)) {
+			Config->Image = ResourceCacheAddSurface("razor.png", Embedded);
+		}
+	}
+
+	for (int DisplayIndex = 0; DisplayIndex < arrlen(App->Displays); DisplayIndex++) {
+		ShaverDisplay* NewDisplay = &App->Displays[DisplayIndex];
+
+		// Each razor gets an equal, disjoint slice of the display's columns so no two razors ever write the same pixel.
+		int RazorCount = arrlen(App->RazorConfigs);
+		arrsetlen(NewDisplay->Razors, RazorCount);
+		arrsetlen(NewDisplay->LaneFills, RazorCount);
+		arrsetlen(NewDisplay->RazorTextures, RazorCount);
+
+		for (int RazorIndex = 0; RazorIndex < RazorCount; RazorIndex++) {
+			RazorState* Razor = &NewDisplay->Razors[RazorIndex];
+			SDL_zerop(Razor);
+
+			int32 LaneStart = NewDisplay->Display.Width * RazorIndex / RazorCount;
+			int32 LaneEnd = NewDisplay->Display.Width * (RazorIndex + 1) / RazorCount;
+			RazorSetLane(Razor, &App->RazorConfigs[RazorIndex], LaneStart, LaneEnd);
+
+			NewDisplay->RazorTextures[RazorIndex] =
+				ResourceCacheAcquireTexture(NewDisplay->Renderer, App->RazorImageIds[RazorIndex]);
+
+			RazorSetPosition(Razor, GetRazorCenterLanePosition((Display*)NewDisplay, Razor));
+			RazorWait(Razor, 1.0f, RazorMoveFinished);
+		}
+	}
+}
+
+void ApplicationLogStartupTimings(ShaverApplication* App)
+{
+	const StartupTimings* Startup = &App->Startup;
+	LogInfo("Startup: SDL init          %8.2f ms", stm_ms(Startup->SDLInitTicks));
+	LogInfo("Startup: Windows/renderers %8.2f ms", stm_ms(Startup->WindowTicks));
+	LogInfo(
+		"Startup: Capture           %8.2f ms (worker, blocked %.2f ms)",
+		stm_ms(Startup->CaptureTicks),
+		stm_ms(Startup->CaptureWaitTicks));
+	LogInfo(
+		"Startup: Razor config      %8.2f ms (worker, blocked %.2f ms until decoded)",
+		stm_ms(Startup->RazorConfigTicks),
+		stm_ms(Startup->RazorWaitTicks));
+	LogInfo("Startup: Texture creation  %8.2f ms", stm_ms(Startup->TextureTicks));
+	LogInfo(
+		"Startup: Image decodes     %8.2f ms (%d on workers)",
+		SDL_GetAtomicInt(&App->Startup.DecodeMicroseconds) / 1000.0,
+		SDL_GetAtomicInt(&App->Startup.DecodeCount));
+	LogInfo("Startup: Initialized in    %8.2f ms", stm_ms(stm_since(Startup->LaunchTicks)));
+}
+
+void ApplicationWriteStartupProfile(ShaverApplication* App)
+{
+	StartupProfileSetValue("first_present_ms", stm_ms(stm_since(App->Startup.LaunchTicks)));
+	StartupProfileSetValue("display_count", (double)arrlen(App->Displays));
+	StartupProfileSetValue("razor_count", (double)arrlen(App->RazorConfigs));
+	StartupProfileSetValue("worker_count", (double)JobsGetWorkerCount());
+	StartupProfileSetValue("image_decode_count", (double)SDL_GetAtomicInt(&App->Startup.DecodeCount));
+	StartupProfileSetValue("image_decode_ms", SDL_GetAtomicInt(&App->Startup.DecodeMicroseconds) / 1000.0);
+	StartupProfileSetValue("asset_pack", (App->AssetPack != NULL) ? 1.0 : 0.0);
+	StartupProfileWriteReport(App->StartupProfilePath);
+}
+
+void ApplicationBeginLiveDesktopMode(ShaverApplication* App)
+{
+	SDL_Window** OwnWindows = NULL;
+	for (int DisplayIndex = 0; DisplayIndex < arrlen(App->Displays); DisplayIndex++) {
+		arrput(OwnWindows, App->Displays[DisplayIndex].Window);
+	}
+
+	App->LiveDesktop = ApplicationBeginLiveDesktop(App->Screenshot, OwnWindows, (int)arrlen(OwnWindows));
+	arrfree(OwnWindows);
+}
+
+void ApplicationUpdateLiveDesktop(ShaverApplication* App)
+{
+	SDL_Rect ChangedRects[32];
+	int ChangedCount = ApplicationPollLiveDesktop(ChangedRects, SDL_arraysize(ChangedRects));
+
+	SDL_Surface* Screenshot = App->Screenshot;
+	int BytesPerPixel = SDL_BYTESPERPIXEL(Screenshot->format);
+
+	// Only the parts of each display's texture that overlap a changed rect are uploaded.
+	for (int RectIndex = 0; RectIndex < ChangedCount; RectIndex++) {
+		for (int DisplayIndex = 0; DisplayIndex < arrlen(App->Displays); DisplayIndex++) {
+			ShaverDisplay* Display = &App->Displays[DisplayIndex];
+			SDL_Rect Overlap;
+			if (Display->ScreenshotTexture == NULL ||
+				!SDL_GetRectIntersection(&ChangedRects[RectIndex], &Display->ScreenshotRect, &Overlap))
+			{
+				continue;
+			}
+
+			const uint8* Pixels = (const uint8*)Screenshot->pixels + Overlap.y * Screenshot->pitch +
+								  Overlap.x * BytesPerPixel;
+			int Pitch = Screenshot->pitch;
+			SDL_Rect TextureRect = {
+				Overlap.x - Display->ScreenshotRect.x,
+				Overlap.y - Display->ScreenshotRect.y,
+				Overlap.w,
+				Overlap.h,
+			};
+
+			if (Display->ScreenshotLevel > 0) {
+				// Grow the rect to whole blocks of the downsampled level, clipped to the blocks the level covers.
+				int32 Level = Display->ScreenshotLevel;
+				int32 LevelMask = (1 << Level) - 1;
+				int32 X0 = TextureRect.x & ~LevelMask;
+				int32 Y0 = TextureRect.y & ~LevelMask;
+				int32 X1 = MIN((TextureRect.x + TextureRect.w + LevelMask) & ~LevelMask,
+							   Display->ScreenshotRect.w & ~LevelMask);
+				int32 Y1 = MIN((TextureRect.y + TextureRect.h + LevelMask) & ~LevelMask,
+							   Display->ScreenshotRect.h & ~LevelMask);
+				if (X1 <= X0 || Y1 <= Y0) {
+					continue;
+				}
+
+				SDL_Rect SourceRect = {Display->ScreenshotRect.x + X0, Display->ScreenshotRect.y + Y0, X1 - X0, Y1 - Y0};
+				Pixels = ApplicationDownsampleScreenshot(App, &SourceRect, Level, &Pitch);
+				if (Pixels == NULL) {
+					continue;
+				}
+				TextureRect = (SDL_Rect){X0 >> Level, Y0 >> Level, (X1 - X0) >> Level, (Y1 - Y0) >> Level};
+			}
+
+			SDL_PixelFormat TextureFormat = Display->ScreenshotTexture->format;
+			if (TextureFormat != Screenshot->format) {
+				int ScratchPitch = TextureRect.w * SDL_BYTESPERPIXEL(TextureFormat);
+				uint8* Scratch = LargeBufferReserve(
+					&App->LiveDesktopScratch,
+					MemoryTag_Screenshot,
+					(size_t)ScratchPitch * TextureRect.h);
+				if (Scratch == NULL) {
+					continue;
+				}
+				SDL_ConvertPixels(
+					TextureRect.w,
+					TextureRect.h,
+					Screenshot->format,
+					Pixels,
+					Pitch,
+					TextureFormat,
+					Scratch,
+					ScratchPitch);
+				Pixels = Scratch;
+				Pitch = ScratchPitch;
+			}
+
+			SDL_UpdateTexture(Display->ScreenshotTexture, &TextureRect, Pixels, Pitch);
+		}
+	}
+}
+
+SDL_Rect ApplicationGetScreenshotRect(ShaverApplication* App, const SDL_Rect* DisplayBounds, const SDL_Point* Origin)
+{
+	SDL_Rect ScreenshotBounds = {0, 0, App->Screenshot->w, App->Screenshot->h};
+	SDL_Rect DisplayRect = {
+		DisplayBounds->x - Origin->x,
+		DisplayBounds->y - Origin->y,
+		DisplayBounds->w,
+		DisplayBounds->h,
+	};
+
+	SDL_Rect Result;
+	if (!SDL_GetRectIntersection(&DisplayRect, &ScreenshotBounds, &Result)) {
+		// Screenshot doesn't line up with the display layout at all (e.g. placeholder capture), show all of it.
+		Result = ScreenshotBounds;
+	}
+	return Result;
+}
+
+// Screenshot levels below full resolution, past a quarter the box filter visibly blurs text.
+#define SCREENSHOT_MAX_LEVEL 2
+
+int32 ApplicationSelectScreenshotLevel(ShaverApplication* App, const ShaverDisplay* Display)
+{
+	// Scaled outputs (e.g. a 4K capture shown in a window with a 1080p pixel size) get a level that still has at least
+	// one texel per window pixel, anything beyond that is memory and upload time the sampler throws away.
+	if (SDL_BYTESPERPIXEL(App->Screenshot->format) != 4) {
+		return 0;
+	}
+
+	const SDL_Rect* Rect = &Display->ScreenshotRect;
+	int32 Level = 0;
+	while (Level < SCREENSHOT_MAX_LEVEL && (Rect->w >> (Level + 1)) >= Display->Display.Width &&
+		   (Rect->h >> (Level + 1)) >= Display->Display.Height)
+	{
+		Level++;
+	}
+	return Level;
+}
+
+// Rect of the screenshot box filtered down Level times into the downsample buffers, NULL when they can't be mapped.
+const uint8* ApplicationDownsampleScreenshot(
+	ShaverApplication* App,
+	const SDL_Rect* Rect,
+	int32 Level,
+	int32* OutPitch)
+{
+	SDL_Surface* Screenshot = App->Screenshot;
+	const uint8* Source = (const uint8*)Screenshot->pixels + Rect->y * Screenshot->pitch + Rect->x * 4;
+	int32 SourcePitch = Screenshot->pitch;
+	int32 Width = Rect->w;
+	int32 Height = Rect->h;
+
+	for (int32 LevelIndex = 0; LevelIndex < Level; LevelIndex++) {
+		Width /= 2;
+		Height /= 2;
+
+		uint8* Buffer =
+			LargeBufferReserve(&App->DownsampleBuffers[LevelIndex & 1], MemoryTag_Screenshot, (size_t)Width * Height * 4);
+		if (Buffer == NULL) {
+			return NULL;
+		}
+		DownsamplePixels2x2(Source, SourcePitch, Buffer, Width * 4, Width, Height);
+
+		Source = Buffer;
+		SourcePitch = Width * 4;
+	}
+
+	*OutPitch = SourcePitch;
+	return Source;
+}
+
+void ApplicationCreateScreenshotTexture(ShaverApplication* App, ShaverDisplay* Display)
+{
+	uint64 StartTicks = stm_now();
+
+	int32 Level = ApplicationSelectScreenshotLevel(App, Display);
+	int32 LevelMask = (1 << Level) - 1;
+	SDL_Rect SourceRect = Display->ScreenshotRect;
+	SourceRect.w &= ~LevelMask;
+	SourceRect.h &= ~LevelMask;
+
+	int32 Pitch;
+	const uint8* Pixels = (Level > 0) ? ApplicationDownsampleScreenshot(App, &SourceRect, Level, &Pitch) : NULL;
+	if (Level > 0 && Pixels == NULL) {
+		LogWarning("Screenshot: No memory to downsample to level %d, using the full resolution", Level);
+		Level = 0;
+	}
+
+	Display->ScreenshotLevel = Level;
+	if (Level == 0) {
+		Display->ScreenshotTexture = ResourceCacheAddTexture(
+			Display->Renderer,
+			"screenshot",
+			CreateTextureFromSurfaceRect(Display->Renderer, App->Screenshot, &Display->ScreenshotRect));
+		return;
+	}
+
+	SDL_Surface* LevelSurface = SDL_CreateSurfaceFrom(
+		SourceRect.w >> Level,
+		SourceRect.h >> Level,
+		App->Screenshot->format,
+		(void*)Pixels,
+		Pitch);
+	Display->ScreenshotTexture = ResourceCacheAddTexture(
+		Display->Renderer,
+		"screenshot",
+		SDL_CreateTextureFromSurface(Display->Renderer, LevelSurface));
+	SDL_DestroySurface(LevelSurface);
+
+	int64 FullBytes = (int64)Display->ScreenshotRect.w * Display->ScreenshotRect.h * 4;
+	int64 LevelBytes = (int64)(SourceRect.w >> Level) * (SourceRect.h >> Level) * 4;
+	LogInfo(
+		"Screenshot: Display %d uses level %d (%dx%d from %dx%d, %.1f MB less texture memory) built in %.2f ms",
+		(int)(Display - App->Displays),
+		Level,
+		SourceRect.w >> Level,
+		SourceRect.h >> Level,
+		Display->ScreenshotRect.w,
+		Display->ScreenshotRect.h,
+		(double)(FullBytes - LevelBytes) / (1024.0 * 1024.0),
+		stm_ms(stm_since(StartTicks)));
+}
+
+SDL_Texture* CreateTextureFromSurfaceRect(SDL_Renderer* Renderer, SDL_Surface* Surface, const SDL_Rect* Rect)
+{
+	// A view over the shared surface's pixels, nothing is copied until the texture upload itself.
+	SDL_Surface* View = SDL_CreateSurfaceFrom(
+		Rect->w,
+		Rect->h,
+		Surface->format,
+		(uint8*)Surface->pixels + Rect->y * Surface->pitch + Rect->x * SDL_BYTESPERPIXEL(Surface->format),
+		Surface->pitch);
+
+	if (View == NULL) {
+		LogError("Unable to create screenshot view: %s", SDL_GetError());
+		return NULL;
+	}
+
+	SDL_Texture* Texture = SDL_CreateTextureFromSurface(Renderer, View);
+	SDL_DestroySurface(View);
+	return Texture;
+}
+
+static void ShaveLaneFillJob(void* UserData)
+{
+	const ShaveLaneFill* Fill = (const ShaveLaneFill*)UserData;
+	PatternFill(Fill->Pattern, Fill->Surface, Fill->Left, Fill->Top, Fill->Right, Fill->Bottom);
+}
+
+// Coverage is updated right away, the pixels are only written once Counter is joined. A NULL Counter fills in place.
+void ApplicationShaveLane(ShaverApplication* App, ShaverDisplay* Display, RazorState* Razor, JobCounter* Counter)
+{
+	SDL_Rect ShaveBounds = PositionToRazorShaveBounds(Razor->Config, Razor->Position);
+	ShaveCoverage* Coverage = &Display->Display.Coverage;
+
+	const PatternImage* Pattern = PatternLibraryGet(Razor->PatternIndex);
+	if (Pattern == NULL) {
+		return;
+	}
+
+	// Writes are clipped to the razor's lane so lanes never overlap and can be filled independently. The bottom isn't
+	// snapped to the pattern, the last stroke has to reach the bottom row whatever the pattern's height.
+	int ShaveBottom = MIN(ShaveBounds.y + ShaveBounds.h, Display->ShavedSurface->h);
+	int ShaveLeft = MAX(ShaveBounds.x, Razor->LaneStart);
+	int ShaveRight = MIN(MIN(ShaveBounds.x + ShaveBounds.w, Razor->LaneEnd), Display->ShavedSurface->w);
+
+	// Rows above the shallowest column under the blade were filled on an earlier frame of this cycle, skip them. The top
+	// is snapped since PatternFill starts the pattern at the row it's given.
+	int ShaveTop = ShaveCoverageMinDepth(Coverage, ShaveLeft, ShaveRight) / Pattern->Height * Pattern->Height;
+
+	if (ShaveLeft < ShaveRight && ShaveTop < ShaveBottom) {
+		ShaveLaneFill* Fill = &Display->LaneFills[Razor - Display->Razors];
+		*Fill = (ShaveLaneFill){Pattern, Display->ShavedSurface, ShaveLeft, ShaveTop, ShaveRight, ShaveBottom};
+		// Blitted patterns go through the blit map SDL caches on the pattern surface, which nothing guards, so only
+		// indexed fills leave the main thread.
+		if (Counter != NULL && Pattern->Surface == NULL) {
+			JobsSubmit(ShaveLaneFillJob, Fill, Counter);
+		} else {
+			ShaveLaneFillJob(Fill);
+		}
+	}
+
+	ShaveCoverageAdd(Coverage, ShaveLeft, ShaveRight, ShaveBottom);
+}
+
+#if DEBUG_OVERLAY
+// Milliseconds of one 60 Hz frame, drawn as a reference line over the graph.
+#define FRAME_GRAPH_BUDGET_MS (1000.0f / 60.0f)
+#define FRAME_GRAPH_PIXELS_PER_MS 4.0f
+#define FRAME_GRAPH_MAX_MS 50.0f
+
+static const Color FramePhaseColors[FramePhase_Count] = {
+	[FramePhase_Update] = {64, 128, 255, 255},
+	[FramePhase_ShaveFill] = {64, 220, 64, 255},
+	[FramePhase_Upload] = {255, 220, 64, 255},
+	[FramePhase_Render] = {255, 140, 32, 255},
+	[FramePhase_Present] = {220, 64, 220, 255},
+	[FramePhase_Wait] = {96, 96, 96, 255},
+};
+
+static const char* FramePhaseColorNames[FramePhase_Count] = {
+	[FramePhase_Update] = "blue",
+	[FramePhase_ShaveFill] = "green",
+	[FramePhase_Upload] = "yellow",
+	[FramePhase_Render] = "orange",
+	[FramePhase_Present] = "magenta",
+	[FramePhase_Wait] = "gray",
+};
+
+// One column per frame along the bottom left of the display, newest on the right, phases stacked bottom up.
+static void ApplicationDrawFrameStats(const ShaverDisplay* Display)
+{
+	FrameStatsSummary Summary;
+	FrameStatsSummarize(&Summary);
+	DebugPrintf(
+		"FRAME: p50 %.2f p95 %.2f p99 %.2f worst %.2f ms (%d frames)",
+		Summary.P50,
+		Summary.P95,
+		Summary.P99,
+		Summary.Worst,
+		Summary.FrameCount);
+	for (int Phase = 0; Phase < FramePhase_Count; Phase++) {
+		DebugPrintf(
+			"  %-10s %.2f ms (%s)",
+			FrameStatsGetPhaseName(Phase),
+			Summary.PhaseAverage[Phase],
+			FramePhaseColorNames[Phase]);
+	}
+
+	float32 Left = 16.0f;
+	float32 Bottom = Display->Display.Height - 16.0f;
+	for (int Age = 0; Age < Summary.FrameCount; Age++) {
+		float32 X = Left + (FRAME_STATS_HISTORY - 1 - Age);
+		float32 Stacked = 0.0f;
+		for (int Phase = 0; Phase < FramePhase_Count && Stacked < FRAME_GRAPH_MAX_MS; Phase++) {
+			float32 Top = SDL_min(Stacked + FrameStatsGetPhaseMS(Age, Phase), FRAME_GRAPH_MAX_MS);
+			if (Top > Stacked) {
+				DebugLine(
+					X,
+					Bottom - Stacked * FRAME_GRAPH_PIXELS_PER_MS,
+					X,
+					Bottom - Top * FRAME_GRAPH_PIXELS_PER_MS,
+					FramePhaseColors[Phase],
+					1);
+			}
+			Stacked = Top;
+		}
+	}
+
+	float32 BudgetY = Bottom - FRAME_GRAPH_BUDGET_MS * FRAME_GRAPH_PIXELS_PER_MS;
+	DebugLine(Left, BudgetY, Left + FRAME_STATS_HISTORY, BudgetY, (Color){255, 255, 255, 255}, 1);
+}
+
+static void ApplicationDrawMemoryStats(void)
+{
+#if MEMORY_TRACKING
+	for (int Tag = 0; Tag < MemoryTag_Count; Tag++) {
+		MemoryTagStats Stats;
+		MemoryTrackerGetStats(Tag, &Stats);
+		DebugPrintf(
+			"MEM %-11s %8.1f MB peak %8.1f MB %6.0f allocs/s %8.1f KB/s",
+			MemoryTrackerGetTagName(Tag),
+			Stats.LiveBytes / (1024.0 * 1024.0),
+			Stats.PeakBytes / (1024.0 * 1024.0),
+			Stats.AllocationsPerSecond,
+			Stats.BytesPerSecond / 1024.0f);
+	}
+#else
+	DebugPrintf("MEM: tracking compiled out, build with MEMORY_TRACKING=1");
+#endif
+}
+#endif
+
 void ApplicationUpdate(ShaverApplication* App, const GameTime* Time)
 {
 	DebugNextFrame();
+	MemoryTrackerUpdate();
 
 	const float32 TimeScale = 1.0f;
 
 	InterpolatorContextUpdate(App->InterpolatorContext, Time->DeltaTimeF * TimeScale);
 
+	if (App->LiveDesktop) {
+		ApplicationUpdateLiveDesktop(App);
+	}
+
+	PatternLibraryUpdate();
+
+	// Every shaving lane of every display is filled at once, the main thread helps out while it waits.
+	uint64 FillTicks = 0;
+	float32 Value = 0.0f;
 	for (int DisplayIndex = 0; DisplayIndex < arrlen(App->Displays); DisplayIndex++) {
 		ShaverDisplay* Display = &App->Displays[DisplayIndex];
 
-		float32 Value = RazorEvaluatePosition(&Display->Razor);
+		for (int RazorIndex = 0; RazorIndex < arrlen(Display->Razors); RazorIndex++) {
+			RazorState* Razor = &Display->Razors[RazorIndex];
+			float32 RazorValue = RazorEvaluatePosition(Razor);
+			if (DisplayIndex == 0 && RazorIndex == 0) {
+				Value = RazorValue;
+			}
 
-		if (Display->Razor.Behavior == RazorBehavior_Shave) {
-			SDL_Rect LastShaveBounds = PositionToRazorShaveBounds(&App->RazorConfig, Display->Razor.LastPosition);
-			SDL_Rect ShaveBounds = PositionToRazorShaveBounds(&App->RazorConfig, Display->Razor.Position);
+			// CycleIndex already points at the next cycle while idling, so that's when its pattern gets picked and
+			// decoded. Patterns that showed up in the meantime are part of the count by then.
+			if (Razor->Behavior == RazorBehavior_Idle) {
+				Razor->PatternIndex = Razor->CycleIndex % PatternLibraryGetCount();
+				PatternLibraryPrefetch(Razor->PatternIndex);
+			} else {
+				PatternLibraryTouch(Razor->PatternIndex);
+			}
 
-			SDL_Surface* Pattern = App->Patterns[Display->Razor.CycleIndex % arrlen(App->Patterns)];
+			if (Razor->Behavior == RazorBehavior_Shave) {
+				uint64 FillStartTicks = stm_now();
+				ApplicationShaveLane(App, Display, Razor, &App->ShaveJob);
+				FillTicks += stm_since(FillStartTicks);
+			}
+		}
+	}
+	uint64 WaitStartTicks = stm_now();
+	JobsWait(&App->ShaveJob);
+	FrameStatsAdd(FramePhase_ShaveFill, FillTicks + stm_since(WaitStartTicks));
 
-			int ShaveBottom = MIN((ShaveBounds.y + ShaveBounds.h) / Pattern->h * Pattern->h, Display->ShavedSurface->h);
-			int ShaveRight = MIN(ShaveBounds.x + ShaveBounds.w, Display->ShavedSurface->w);
+	for (int DisplayIndex = 0; DisplayIndex < arrlen(App->Displays); DisplayIndex++) {
+		ShaverDisplay* Display = &App->Displays[DisplayIndex];
 
-			for (int ShaveY = LastShaveBounds.y / Pattern->h * Pattern->h; ShaveY < ShaveBottom; ShaveY += Pattern->h) {
-				for (int ShaveX = ShaveBounds.x; ShaveX < ShaveRight; ShaveX += Pattern->w) {
-					SDL_BlitSurface(
-						Pattern,
-						NULL,
-						Display->ShavedSurface,
-						&(SDL_Rect){ShaveX, ShaveY, Pattern->w, Pattern->h});
+		// Only the region newly covered this frame needs to reach the GPU.
+		const SDL_Rect* Dirty = &Display->Display.Coverage.Dirty;
+		if (!SDL_RectEmpty(Dirty)) {
+			uint64 UploadStartTicks = stm_now();
+			void* TexturePixels;
+			int TexturePitch;
+			if (SDL_LockTexture(Display->ShavedTexture, Dirty, &TexturePixels, &TexturePitch)) {
+				const SDL_Surface* Source = Display->ShavedSurface;
+				const uint8* SourceRow = (const uint8*)Source->pixels + Dirty->y * Source->pitch + Dirty->x * 4;
+				uint8* DestRow = (uint8*)TexturePixels;
+				for (int Row = 0; Row < Dirty->h; Row++) {
+					SDL_memcpy(DestRow, SourceRow, Dirty->w * 4);
+					SourceRow += Source->pitch;
+					DestRow += TexturePitch;
 				}
+				SDL_UnlockTexture(Display->ShavedTexture);
 			}
-
-			SDL_Surface* ShavedSurface;
-			SDL_LockTextureToSurface(Display->ShavedTexture, NULL, &ShavedSurface);
-			SDL_memcpy(
-				ShavedSurface->pixels,
-				Display->ShavedSurface->pixels,
-				Display->ShavedSurface->pitch * Display->ShavedSurface->h);
-			SDL_UnlockTexture(Display->ShavedTexture);
+			FrameStatsAdd(FramePhase_Upload, stm_since(UploadStartTicks));
 		}
+		ShaveCoverageClearDirty(&Display->Display.Coverage);
 
+#if DEBUG_OVERLAY
 		if (DisplayIndex == 0) {
-			DebugPrintf("POS: %0.1f, %0.1f", Display->Razor.Position.X, Display->Razor.Position.Y);
-			DebugPrintf("START: %0.1f, %0.1f", Display->Razor.StartPosition.X, Display->Razor.StartPosition.Y);
-			DebugPrintf("TARGET: %0.1f, %0.1f", Display->Razor.TargetPosition.X, Display->Razor.TargetPosition.Y);
-			DebugPrintf("STATE: %s", GetRazorBehaviorName(Display->Razor.Behavior));
+			for (int RazorIndex = 0; App->EnableDebugDraw && RazorIndex < arrlen(Display->Razors); RazorIndex++) {
+				const RazorState* Razor = &Display->Razors[RazorIndex];
+				SDL_Rect Bounds = PositionToRazorShaveBounds(Razor->Config, Razor->Position);
+				Color BoundsColor = (Razor->Behavior == RazorBehavior_Shave) ? (Color){255, 64, 64, 255}
+																				: (Color){128, 128, 128, 255};
+				DebugBox(Bounds.x, Bounds.y, Bounds.x + Bounds.w, Bounds.y + Bounds.h, BoundsColor, 1);
+			}
+
+			const RazorState* Razor = &Display->Razors[0];
+			DebugPrintf("RAZORS: %d", (int)arrlen(Display->Razors));
+			DebugPrintf("COVERED: %0.1f%%", ShaveCoveragePercent(&Display->Display.Coverage));
+			DebugPrintf(
+				"PATTERNS: %d/%d resident, %d KB",
+				PatternLibraryGetResidentCount(),
+				PatternLibraryGetCount(),
+				(int)(PatternLibraryGetResidentBytes() / 1024));
+			DebugPrintf(
+				"IMAGES: %d surfaces %d KB, %d textures %d KB",
+				ResourceCacheGetSurfaceCount(),
+				(int)(ResourceCacheGetSurfaceBytes() / 1024),
+				ResourceCacheGetTextureCount(),
+				(int)(ResourceCacheGetTextureBytes() / 1024));
+			DebugPrintf("POS: %0.1f, %0.1f", Razor->Position.X, Razor->Position.Y);
+			DebugPrintf("START: %0.1f, %0.1f", Razor->StartPosition.X, Razor->StartPosition.Y);
+			DebugPrintf("TARGET: %0.1f, %0.1f", Razor->TargetPosition.X, Razor->TargetPosition.Y);
+			DebugPrintf("STATE: %s", GetRazorBehaviorName(Razor->Behavior));
 			DebugPrintf("VALUE: %f", Value);
+
+			if (App->EnableFrameStats) {
+				ApplicationDrawFrameStats(Display);
+			}
+			if (App->EnableMemoryStats) {
+				ApplicationDrawMemoryStats();
+			}
 		}
+#endif
+	}
+
+	// Every pattern, coverage and debug buffer has been through a whole cycle by the time each razor finished one,
+	// frames from then on shouldn't touch the heap.
+	bool CycleDone = arrlen(App->Displays) > 0;
+	for (int DisplayIndex = 0; CycleDone && DisplayIndex < arrlen(App->Displays); DisplayIndex++) {
+		const ShaverDisplay* Display = &App->Displays[DisplayIndex];
+		for (int RazorIndex = 0; CycleDone && RazorIndex < arrlen(Display->Razors); RazorIndex++) {
+			CycleDone = Display->Razors[RazorIndex].CycleIndex > 0;
+		}
+	}
+	if (CycleDone) {
+		MemoryTrackerArmSteadyState();
 	}
 }
 
 void ApplicationRender(ShaverApplication* App)
 {
+	// The first frame includes driver warmup (shader compilation, first uploads), profiled on its own.
+	bool FirstFrame = !App->Startup.FirstFramePresented;
+	if (FirstFrame) {
+		StartupProfileBegin("first_render");
+	}
+
 	for (int DisplayIndex = 0; DisplayIndex < arrlen(App->Displays); DisplayIndex++) {
 		ShaverDisplay* Display = &App->Displays[DisplayIndex];
 
@@ -394,21 +1357,23 @@ void ApplicationRender(ShaverApplication* App)
 			SDL_SetTextureColorModFloat(Display->ScreenshotTexture, 1.0f, 1.0f, 1.0f);
 		}
 
-		SDL_FRect DisplayBounds;
-		SDL_RectToFRect(&Display->Bounds, &DisplayBounds);
-		SDL_RenderTexture(Display->Renderer, Display->ScreenshotTexture, &DisplayBounds, NULL);
+		SDL_RenderTexture(Display->Renderer, Display->ScreenshotTexture, NULL, NULL);
 		SDL_RenderTexture(Display->Renderer, Display->ShavedTexture, NULL, NULL);
 
-		SDL_RenderTexture(
-			Display->Renderer,
-			Display->RazorTexture,
-			NULL,
-			&(SDL_FRect){Display->Razor.Position.X,
-						 Display->Razor.Position.Y,
-						 App->RazorConfig.Image->w,
-						 App->RazorConfig.Image->h});
+		for (int RazorIndex = 0; RazorIndex < arrlen(Display->Razors); RazorIndex++) {
+			const RazorState* Razor = &Display->Razors[RazorIndex];
+			// Only without any image at all, see ApplicationCreateDisplayRazors. The razor still shaves, unseen.
+			if (Razor->Config->Image == NULL) {
+				continue;
+			}
+			SDL_RenderTexture(
+				Display->Renderer,
+				Display->RazorTextures[RazorIndex],
+				NULL,
+				&(SDL_FRect){Razor->Position.X, Razor->Position.Y, Razor->Config->Image->w, Razor->Config->Image->h});
+		}
 
-#ifdef _DEBUG
+#if DEBUG_OVERLAY
 		if (App->EnableDebugDraw) {
 			if (DisplayIndex == 0) {
 				DebugDraw(Display->Renderer);
@@ -416,7 +1381,26 @@ void ApplicationRender(ShaverApplication* App)
 		}
 #endif
 
+		if (FirstFrame) {
+			StartupProfileBegin("present");
+		}
+		uint64 PresentStartTicks = stm_now();
 		SDL_RenderPresent(Display->Renderer);
+		FrameStatsAdd(FramePhase_Present, stm_since(PresentStartTicks));
+		if (FirstFrame) {
+			StartupProfileEnd();
+		}
+	}
+
+	if (FirstFrame) {
+		StartupProfileEnd();
+		App->Startup.FirstFramePresented = true;
+		LogInfo("Startup: First frame presented %.2f ms after launch", stm_ms(stm_since(App->Startup.LaunchTicks)));
+
+		if (App->StartupProfilePath != NULL) {
+			ApplicationWriteStartupProfile(App);
+			ApplicationStopRunning(App);
+		}
 	}
 }
 
@@ -459,17 +1443,20 @@ void ApplicationDebugKeyDown(ShaverApplication* App, SDL_Scancode scancode)
 {
 	switch (scancode) {
 		case SDL_SCANCODE_F1: TOGGLE(App->EnableDebugDraw); break;
+		case SDL_SCANCODE_F2: TOGGLE(App->EnableFrameStats); break;
+		case SDL_SCANCODE_F3: TOGGLE(App->EnableMemoryStats); break;
 		default: break;
 	}
 }
 
-bool LoadImage(const char* FileName, SDL_Surface** OutSurface)
+static void FreeImagePixels(void* UserData, void* Pixels)
 {
-	*OutSurface = NULL;
-
-	int Width, Height, Channels;
-	stbi_uc* ImageData = stbi_load(FileName, &Width, &Height, &Channels, 4);
+	stbi_image_free(Pixels);
+}
 
+// Wraps stb_image's buffer without copying, the surface frees it when destroyed.
+static bool CreateImageSurface(stbi_uc* ImageData, int Width, int Height, SDL_Surface** OutSurface)
+{
 	if (!ImageData) {
 		return false;
 	}
@@ -477,42 +1464,56 @@ bool LoadImage(const char* FileName, SDL_Surface** OutSurface)
 	SDL_Surface* Surface = SDL_CreateSurfaceFrom(Width, Height, SDL_PIXELFORMAT_RGBA32, ImageData, Width * 4);
 
 	if (!Surface) {
+		stbi_image_free(ImageData);
 		return false;
 	}
 
+	SDL_SetPointerPropertyWithCleanup(
+		SDL_GetSurfaceProperties(Surface),
+		"shaver.image.pixels",
+		ImageData,
+		FreeImagePixels,
+		NULL);
+
 	*OutSurface = Surface;
 	return true;
 }
 
-bool LoadImageFromMemory(const void* Data, size_t Bytes, SDL_Surface** OutSurface)
+bool LoadImage(const char* FileName, SDL_Surface** OutSurface)
 {
 	*OutSurface = NULL;
 
 	int Width, Height, Channels;
-	stbi_uc* ImageData = stbi_load_from_memory((stbi_uc*)Data, Bytes, &Width, &Height, &Channels, 4);
-
-	if (!ImageData) {
-		return false;
-	}
-
-	SDL_Surface* Surface = SDL_CreateSurfaceFrom(Width, Height, SDL_PIXELFORMAT_RGBA32, ImageData, Width * 4);
+	stbi_uc* ImageData = stbi_load(FileName, &Width, &Height, &Channels, 4);
+	return CreateImageSurface(ImageData, Width, Height, OutSurface);
+}
 
-	if (!Surface) {
-		return false;
-	}
+bool LoadImageFromMemory(const void* Data, size_t Bytes, SDL_Surface** OutSurface)
+{
+	*OutSurface = NULL;
 
-	*OutSurface = Surface;
-	return true;
+	int Width, Height, Channels;
+	stbi_uc* ImageData = stbi_load_from_memory((stbi_uc*)Data, Bytes, &Width, &Height, &Channels, 4);
+	return CreateImageSurface(ImageData, Width, Height, OutSurface);
 }
 
 Display* GetDisplayForRazor(Application* App, RazorState* Razor)
 {
 	ShaverApplication* _App = (ShaverApplication*)App;
 	for (int DisplayIndex = 0, DisplayCount = arrlen(_App->Displays); DisplayIndex < DisplayCount; DisplayIndex++) {
-		if (&_App->Displays[DisplayIndex].Razor == Razor) {
-			return (Display*)&_App->Displays[DisplayIndex];
+		ShaverDisplay* Candidate = &_App->Displays[DisplayIndex];
+		if (Razor >= Candidate->Razors && Razor < Candidate->Razors + arrlen(Candidate->Razors)) {
+			return (Display*)Candidate;
 		}
 	}
 
 	return NULL;
+}
+
+void FillRazorLane(Application* App, RazorState* Razor)
+{
+	ShaverDisplay* Display = (ShaverDisplay*)GetDisplayForRazor(App, Razor);
+	if (Display != NULL) {
+		ApplicationShaveLane((ShaverApplication*)App, Display, Razor, NULL);
+	}
 }
\ No newline at end of file
@@ -4,7 +4,10 @@
 #include "Types.h"
 
 typedef struct ApplicationConfig {
-
+	bool LiveDesktop; // Keep the unshaved area in sync with the desktop, also enabled by "live_desktop" in config.json
+	// Startup profile mode: write a JSON breakdown of activation time here and exit after the first presented frame.
+	// NULL runs normally, must outlive the application.
+	const char* StartupProfilePath;
 } ApplicationConfig;
 
 typedef struct Application Application;
@@ -17,4 +20,17 @@ void ApplicationRun(Application *App);
 SDL_Window *GetApplicationWindow(Application *App);
 
 typedef struct SDL_Surface SDL_Surface;
-bool ApplicationTakeDesktopScreenshot(SDL_Surface **OutSurface);
\ No newline at end of file
+bool ApplicationTakeDesktopScreenshot(SDL_Surface **OutSurface);
+
+// Decode to SDL_PIXELFORMAT_RGBA32, safe to call from job workers.
+bool LoadImage(const char* FileName, SDL_Surface** OutSurface);
+bool LoadImageFromMemory(const void* Data, size_t Bytes, SDL_Surface** OutSurface);
+
+// Live desktop, implemented per platform. Begin starts tracking changes to the desktop underneath OwnWindows, Poll
+// refreshes changed areas in the screenshot surface and returns how many rects (in screenshot coordinates) it wrote to
+// OutRects, collapsing them into one bounding rect when there are more than MaxRects. A platform may refresh only part
+// of the changes per call and leave the rest for the next one.
+typedef struct SDL_Rect SDL_Rect;
+bool ApplicationBeginLiveDesktop(SDL_Surface *Screenshot, SDL_Window **OwnWindows, int OwnWindowCount);
+int ApplicationPollLiveDesktop(SDL_Rect *OutRects, int MaxRects);
+void ApplicationEndLiveDesktop(void);
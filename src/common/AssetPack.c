@@ -0,0 +1,222 @@
+#include "AssetPack.h"
+
+#include <SDL3/SDL.h>
+
+#include "Log.h"
+
+#if __LINUX__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+_Static_assert(SDL_BYTEORDER == SDL_LIL_ENDIAN, "Asset packs are read in place and are little endian");
+
+struct AssetPack {
+	const uint8* Base;
+	uint64 Bytes;
+	const AssetPackHeader* Header;
+	const AssetPackEntry* Entries;
+#if !__LINUX__
+	HANDLE File;
+	HANDLE Mapping;
+#endif
+};
+
+static bool AssetPackMap(AssetPack* Pack, const char* FileName)
+{
+#if __LINUX__
+	int File = open(FileName, O_RDONLY);
+	if (File < 0) {
+		return false;
+	}
+
+	struct stat Stat;
+	if (fstat(File, &Stat) != 0 || Stat.st_size == 0) {
+		close(File);
+		return false;
+	}
+
+	void* Base = mmap(NULL, (size_t)Stat.st_size, PROT_READ, MAP_PRIVATE, File, 0);
+	close(File);
+	if (Base == MAP_FAILED) {
+		return false;
+	}
+
+	Pack->Base = Base;
+	Pack->Bytes = (uint64)Stat.st_size;
+	return true;
+#else
+	Pack->File = CreateFileA(FileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (Pack->File == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER Size;
+	if (!GetFileSizeEx(Pack->File, &Size) || Size.QuadPart == 0) {
+		CloseHandle(Pack->File);
+		return false;
+	}
+
+	Pack->Mapping = CreateFileMappingA(Pack->File, NULL, PAGE_READONLY, 0, 0, NULL);
+	Pack->Base = Pack->Mapping ? MapViewOfFile(Pack->Mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+	if (Pack->Base == NULL) {
+		if (Pack->Mapping) {
+			CloseHandle(Pack->Mapping);
+		}
+		CloseHandle(Pack->File);
+		return false;
+	}
+
+	Pack->Bytes = (uint64)Size.QuadPart;
+	return true;
+#endif
+}
+
+static void AssetPackUnmap(AssetPack* Pack)
+{
+#if __LINUX__
+	munmap((void*)Pack->Base, Pack->Bytes);
+#else
+	UnmapViewOfFile(Pack->Base);
+	CloseHandle(Pack->Mapping);
+	CloseHandle(Pack->File);
+#endif
+}
+
+static const char* AssetPackValidate(const AssetPack* Pack)
+{
+	if (Pack->Bytes < sizeof(AssetPackHeader)) {
+		return "truncated header";
+	}
+
+	const AssetPackHeader* Header = Pack->Header;
+	if (Header->Magic != ASSET_PACK_MAGIC) {
+		return "bad magic";
+	}
+	if (Header->Version != ASSET_PACK_VERSION) {
+		return "unsupported version";
+	}
+	if (Header->EntryBytes != sizeof(AssetPackEntry)) {
+		return "entry size mismatch";
+	}
+	if (Header->FileBytes != Pack->Bytes) {
+		return "file size mismatch";
+	}
+	// Offsets and sizes come from the file, compared by subtraction so a crafted one can't wrap around the sum.
+	if (Header->IndexOffset % _Alignof(AssetPackEntry) != 0 || Header->IndexOffset > Pack->Bytes ||
+		(uint64)Header->EntryCount * sizeof(AssetPackEntry) > Pack->Bytes - Header->IndexOffset)
+	{
+		return "index out of bounds";
+	}
+
+	const AssetPackEntry* Entries = (const AssetPackEntry*)(Pack->Base + Header->IndexOffset);
+	for (uint32 Index = 0; Index < Header->EntryCount; Index++) {
+		const AssetPackEntry* Entry = &Entries[Index];
+		if (Entry->Offset % ASSET_PACK_DATA_ALIGNMENT != 0 || Entry->Offset > Pack->Bytes ||
+			Entry->Bytes > Pack->Bytes - Entry->Offset || (uint64)Entry->Pitch * Entry->Height > Entry->Bytes ||
+			Entry->Pitch < (uint64)Entry->Width * SDL_BYTESPERPIXEL((SDL_PixelFormat)Entry->Format) ||
+			Entry->Name[ASSET_PACK_NAME_LENGTH - 1] != '\0')
+		{
+			return "entry out of bounds";
+		}
+	}
+
+	return NULL;
+}
+
+AssetPack* AssetPackOpen(const char* FileName)
+{
+	AssetPack* Pack = SDL_malloc(sizeof(AssetPack));
+	SDL_zerop(Pack);
+
+	if (!AssetPackMap(Pack, FileName)) {
+		LogInfo("AssetPack: No pack at '%s'", FileName);
+		SDL_free(Pack);
+		return NULL;
+	}
+
+	// Nothing past the mapping is looked at until the header checks pass, the index may point anywhere.
+	Pack->Header = (const AssetPackHeader*)Pack->Base;
+	const char* Error = AssetPackValidate(Pack);
+	if (Error != NULL) {
+		LogWarning("AssetPack: Ignoring '%s', %s", FileName, Error);
+		AssetPackUnmap(Pack);
+		SDL_free(Pack);
+		return NULL;
+	}
+	Pack->Entries = (const AssetPackEntry*)(Pack->Base + Pack->Header->IndexOffset);
+
+	LogInfo(
+		"AssetPack: Mapped '%s', %u entries in %" SDL_PRIu64 " KB",
+		FileName,
+		Pack->Header->EntryCount,
+		Pack->Bytes / 1024);
+	return Pack;
+}
+
+void AssetPackClose(AssetPack* Pack)
+{
+	if (Pack == NULL) {
+		return;
+	}
+	AssetPackUnmap(Pack);
+	SDL_free(Pack);
+}
+
+int32 AssetPackGetCount(const AssetPack* Pack)
+{
+	return Pack ? (int32)Pack->Header->EntryCount : 0;
+}
+
+const AssetPackEntry* AssetPackGetEntry(const AssetPack* Pack, int32 Index)
+{
+	ASSERT(VALID_INDEX(Index, AssetPackGetCount(Pack)));
+	return &Pack->Entries[Index];
+}
+
+const void* AssetPackGetPixels(const AssetPack* Pack, int32 Index)
+{
+	return Pack->Base + AssetPackGetEntry(Pack, Index)->Offset;
+}
+
+int32 AssetPackFind(const AssetPack* Pack, const char* Name)
+{
+	if (Pack == NULL || Name == NULL) {
+		return -1;
+	}
+
+	const char* FileName = Name;
+	for (const char* Cursor = Name; *Cursor; Cursor++) {
+		if (*Cursor == '/' || *Cursor == '\\') {
+			FileName = Cursor + 1;
+		}
+	}
+
+	for (int32 Index = 0; Index < AssetPackGetCount(Pack); Index++) {
+		if (SDL_strcmp(Pack->Entries[Index].Name, FileName) == 0) {
+			return Index;
+		}
+	}
+	return -1;
+}
+
+SDL_Surface* AssetPackCreateSurface(const AssetPack* Pack, const char* Name)
+{
+	int32 Index = AssetPackFind(Pack, Name);
+	if (Index < 0) {
+		return NULL;
+	}
+
+	const AssetPackEntry* Entry = AssetPackGetEntry(Pack, Index);
+	return SDL_CreateSurfaceFrom(
+		(int)Entry->Width,
+		(int)Entry->Height,
+		(SDL_PixelFormat)Entry->Format,
+		(void*)AssetPackGetPixels(Pack, Index),
+		(int)Entry->Pitch);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Types.h"
+
+// Pre-decoded asset pack. Built from assets/*.png by tools/assetpacker, mapped read-only at runtime so surfaces are
+// views straight over the mapping with nothing decoded or copied. All fields are little endian.
+//
+// Layout: AssetPackHeader, EntryCount AssetPackEntry records, then each entry's pixels starting on an
+// ASSET_PACK_DATA_ALIGNMENT boundary.
+
+#define ASSET_PACK_MAGIC 0x4B505353 // "SSPK"
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_DATA_ALIGNMENT 64
+#define ASSET_PACK_NAME_LENGTH 48
+
+typedef struct AssetPackHeader {
+	uint32 Magic;
+	uint32 Version;
+	uint32 EntryCount;
+	uint32 EntryBytes; // sizeof(AssetPackEntry) when written, readers reject anything else
+	uint64 IndexOffset;
+	uint64 FileBytes;
+} AssetPackHeader;
+
+typedef struct AssetPackEntry {
+	char Name[ASSET_PACK_NAME_LENGTH]; // File name without directory, nul terminated
+	uint32 Width;
+	uint32 Height;
+	uint32 Pitch;
+	uint32 Format; // SDL_PixelFormat, SDL_PIXELFORMAT_RGBA32 for everything the packer writes
+	uint64 Offset; // From the start of the file
+	uint64 Bytes;
+} AssetPackEntry;
+
+_Static_assert(sizeof(AssetPackHeader) == 32, "AssetPackHeader layout is part of the file format");
+_Static_assert(sizeof(AssetPackEntry) == 80, "AssetPackEntry layout is part of the file format");
+
+typedef struct AssetPack AssetPack;
+typedef struct SDL_Surface SDL_Surface;
+
+// Returns NULL when the file is missing or fails validation, the reason is logged.
+AssetPack* AssetPackOpen(const char* FileName);
+// Every surface created from the pack must be destroyed before closing it.
+void AssetPackClose(AssetPack* Pack);
+
+int32 AssetPackGetCount(const AssetPack* Pack);
+const AssetPackEntry* AssetPackGetEntry(const AssetPack* Pack, int32 Index);
+const void* AssetPackGetPixels(const AssetPack* Pack, int32 Index);
+// Matches on the file name only so both "razor.png" and "assets/razor.png" find the same entry. -1 when not packed.
+int32 AssetPackFind(const AssetPack* Pack, const char* Name);
+
+// Zero copy surface over the mapping, NULL when Name isn't packed. The pixels are read-only, only blit from it.
+SDL_Surface* AssetPackCreateSurface(const AssetPack* Pack, const char* Name);
@@ -1,7 +1,7 @@
 #include "Debug.h"
 
 #include <SDL3/SDL.h>
-#include <stdarg.h>
+#include <stb_ds.h>
 
 #define SYSFONT_U8 uint8
 #define SYSFONT_U16 uint16
@@ -9,18 +9,54 @@
 #define SYSFONT_IMPLEMENTATION
 #include "sysfont.h"
 
-struct line {
-	SDL_FPoint Points[16];
-	int32 PointCount;
+// Glyph layout of the sysfont texture, 9x16 cells in rows of 28 starting at the top left.
+#define DEBUG_GLYPH_WIDTH 9
+#define DEBUG_GLYPH_HEIGHT 16
+#define DEBUG_GLYPHS_PER_ROW 28
+
+// Reserved at initialize so switching an overlay on mid run doesn't grow the buffers in a steady state frame. Covers
+// the frame graph and every stats page at once, more still works but allocates.
+#define DEBUG_RESERVED_SEGMENTS 2048
+#define DEBUG_RESERVED_GLYPHS 4096
+// Per DebugPrintf, arguments past it format as missing.
+#define DEBUG_MAX_ARGS 64
+
+// Only live segments are stored, expired ones are swapped out so per frame work scales with what's on screen.
+typedef struct DebugSegment {
+	SDL_FPoint From;
+	SDL_FPoint To;
+	SDL_FColor Color;
 	int32 FramesRemaining;
-	SDL_Color Color;
-};
+} DebugSegment;
+
+// DebugPrintf only records, formatting waits for DebugDraw. String arguments are copied into TextStrings, which moves
+// as it grows, so their LogArg holds the offset (in Int) instead of the pointer until it is formatted.
+typedef struct DebugTextCommand {
+	const char* Format;
+	int32 FirstArg;
+	int32 ArgCount;
+	SDL_Point Position;
+} DebugTextCommand;
+
+typedef struct DebugAtlas {
+	SDL_Renderer* Renderer;
+	SDL_Texture* Texture;
+} DebugAtlas;
 
 static struct {
-	struct line LinesRingBuffer[1024 * 4];
-	int32 LinesRingIndex;
-	SDL_Surface* Canvas;
-	SDL_Texture* CanvasTexture;
+	DebugSegment* Segments;
+	SDL_Vertex* Vertices; // Scratch for DebugDraw, 4 per segment
+	int* Indices;		  // 6 per segment
+	bool GeometryValid;	  // Vertices match Segments, several renderers can draw the same frame
+	SDL_Surface* Glyphs;  // Baked once, white on transparent, tinted per vertex
+	DebugAtlas* Atlases;
+	DebugTextCommand* TextCommands;
+	LogArg* TextArgs;
+	char* TextStrings;
+	SDL_Vertex* TextVertices; // Built from TextCommands by DebugDraw, 4 per glyph
+	int* TextIndices;
+	bool TextValid;
+	SDL_Point CanvasSize;
 	SDL_Point CursorPos;
 	SDL_Rect CanvasFrameRect;
 	uint32 BackgroundColor;
@@ -28,8 +64,6 @@ static struct {
 	uint32 Margin;
 } GDebug;
 
-static void DebugCreateOrFixupCanvas(SDL_Renderer* renderer);
-
 void DebugInitialize(const DebugConfig* config)
 {
 	DebugConfig Config = (config != NULL) ? *config
@@ -38,75 +72,213 @@ void DebugInitialize(const DebugConfig* config)
 												.CanvasHeight = 180,
 											};
 
-	GDebug.Canvas = SDL_CreateSurface(Config.CanvasWidth, Config.CanvasHeight, SDL_PIXELFORMAT_ARGB8888);
-	ASSERT(GDebug.Canvas);
+	GDebug.Glyphs = SDL_CreateSurface(SYSFONT_TEXWIDTH, SYSFONT_TEXHEIGHT, SDL_PIXELFORMAT_ARGB8888);
+	ASSERT(GDebug.Glyphs);
+	sysfont_texture_u32(GDebug.Glyphs->pixels, GDebug.Glyphs->pitch, 0xFFFFFFFF, 0x00000000);
+
+	GDebug.CanvasSize = (SDL_Point){Config.CanvasWidth, Config.CanvasHeight};
 
 	GDebug.BackgroundColor = Config.BackgroundColor;
 	GDebug.ForegroundColor = (Config.ForegroundColor != 0) ? Config.ForegroundColor : 0xFFFFFFFF;
 	GDebug.Margin = Config.Margin;
+
+#if DEBUG_OVERLAY
+	arrsetcap(GDebug.Segments, DEBUG_RESERVED_SEGMENTS);
+	arrsetcap(GDebug.Vertices, DEBUG_RESERVED_SEGMENTS * 4);
+	arrsetcap(GDebug.Indices, DEBUG_RESERVED_SEGMENTS * 6);
+	arrsetcap(GDebug.TextCommands, 256);
+	arrsetcap(GDebug.TextArgs, 1024);
+	arrsetcap(GDebug.TextStrings, 16 * 1024);
+	arrsetcap(GDebug.TextVertices, DEBUG_RESERVED_GLYPHS * 4);
+	arrsetcap(GDebug.TextIndices, DEBUG_RESERVED_GLYPHS * 6);
+#endif
 }
 
 void DebugShutdown(void)
 {
-	SDL_DestroySurface(GDebug.Canvas);
-	SDL_DestroyTexture(GDebug.CanvasTexture);
+	for (int32 Index = 0; Index < arrlen(GDebug.Atlases); Index++) {
+		SDL_DestroyTexture(GDebug.Atlases[Index].Texture);
+	}
+	arrfree(GDebug.Atlases);
+	SDL_DestroySurface(GDebug.Glyphs);
+	arrfree(GDebug.Segments);
+	arrfree(GDebug.Vertices);
+	arrfree(GDebug.Indices);
+	arrfree(GDebug.TextCommands);
+	arrfree(GDebug.TextArgs);
+	arrfree(GDebug.TextStrings);
+	arrfree(GDebug.TextVertices);
+	arrfree(GDebug.TextIndices);
+	SDL_zero(GDebug);
 }
 
 void DebugNextFrame(void)
 {
-	for (int32 Index = 0; Index < ARRAY_COUNT(GDebug.LinesRingBuffer); Index++) {
-		if (GDebug.LinesRingBuffer[Index].FramesRemaining > 0) {
-			GDebug.LinesRingBuffer[Index].FramesRemaining--;
+	for (int32 Index = arrlen(GDebug.Segments) - 1; Index >= 0; Index--) {
+		if (--GDebug.Segments[Index].FramesRemaining <= 0) {
+			arrdelswap(GDebug.Segments, Index);
 		}
 	}
+	GDebug.GeometryValid = false;
 
-	SDL_FillSurfaceRect(GDebug.Canvas, NULL, 0x00000000);
+	arrsetlen(GDebug.TextCommands, 0);
+	arrsetlen(GDebug.TextArgs, 0);
+	arrsetlen(GDebug.TextStrings, 0);
+	GDebug.TextValid = false;
 	ZERO_STRUCT(&GDebug.CursorPos);
 	GDebug.CanvasFrameRect = (SDL_Rect){0};
 	GDebug.CanvasFrameRect.h = GDebug.Margin * 2;
 }
 
-void DebugDraw(SDL_Renderer* renderer)
+// Every segment becomes a one pixel wide quad, colour travels per vertex so the whole list is one draw call.
+static void DebugBuildGeometry(void)
+{
+	int32 SegmentCount = arrlen(GDebug.Segments);
+	arrsetlen(GDebug.Vertices, SegmentCount * 4);
+	arrsetlen(GDebug.Indices, SegmentCount * 6);
+
+	for (int32 Index = 0; Index < SegmentCount; Index++) {
+		const DebugSegment* Segment = &GDebug.Segments[Index];
+		float DeltaX = Segment->To.x - Segment->From.x;
+		float DeltaY = Segment->To.y - Segment->From.y;
+		float Length = SDL_sqrtf(DeltaX * DeltaX + DeltaY * DeltaY);
+		float Scale = (Length > 0.0f) ? 0.5f / Length : 0.0f;
+		// Half a pixel to either side, degenerate segments still cover their pixel.
+		float NormalX = (Length > 0.0f) ? -DeltaY * Scale : 0.5f;
+		float NormalY = (Length > 0.0f) ? DeltaX * Scale : 0.5f;
+
+		SDL_Vertex* Vertex = &GDebug.Vertices[Index * 4];
+		Vertex[0] = (SDL_Vertex){{Segment->From.x + NormalX, Segment->From.y + NormalY}, Segment->Color};
+		Vertex[1] = (SDL_Vertex){{Segment->From.x - NormalX, Segment->From.y - NormalY}, Segment->Color};
+		Vertex[2] = (SDL_Vertex){{Segment->To.x - NormalX, Segment->To.y - NormalY}, Segment->Color};
+		Vertex[3] = (SDL_Vertex){{Segment->To.x + NormalX, Segment->To.y + NormalY}, Segment->Color};
+
+		int* Quad = &GDebug.Indices[Index * 6];
+		int First = Index * 4;
+		Quad[0] = First + 0;
+		Quad[1] = First + 1;
+		Quad[2] = First + 2;
+		Quad[3] = First + 0;
+		Quad[4] = First + 2;
+		Quad[5] = First + 3;
+	}
+
+	GDebug.GeometryValid = true;
+}
+
+// The glyph texture is uploaded once per renderer and never touched again.
+static SDL_Texture* DebugGetAtlas(SDL_Renderer* Renderer)
+{
+	for (int32 Index = 0; Index < arrlen(GDebug.Atlases); Index++) {
+		if (GDebug.Atlases[Index].Renderer == Renderer) {
+			return GDebug.Atlases[Index].Texture;
+		}
+	}
+
+	SDL_Texture* Texture = SDL_CreateTextureFromSurface(Renderer, GDebug.Glyphs);
+	SDL_SetTextureScaleMode(Texture, SDL_SCALEMODE_NEAREST);
+	SDL_SetTextureBlendMode(Texture, SDL_BLENDMODE_BLEND);
+	arrput(GDebug.Atlases, ((DebugAtlas){Renderer, Texture}));
+	return Texture;
+}
+
+static void DebugAddGlyph(uint8 Char, float X, float Y, SDL_FColor Color)
+{
+	if (X + DEBUG_GLYPH_WIDTH <= 0.0f || Y + DEBUG_GLYPH_HEIGHT <= 0.0f || X >= GDebug.CanvasSize.x ||
+		Y >= GDebug.CanvasSize.y)
+	{
+		return;
+	}
+
+	float U0 = (float)(Char % DEBUG_GLYPHS_PER_ROW * DEBUG_GLYPH_WIDTH) / SYSFONT_TEXWIDTH;
+	float V0 = (float)(Char / DEBUG_GLYPHS_PER_ROW * DEBUG_GLYPH_HEIGHT) / SYSFONT_TEXHEIGHT;
+	float U1 = U0 + (float)DEBUG_GLYPH_WIDTH / SYSFONT_TEXWIDTH;
+	float V1 = V0 + (float)DEBUG_GLYPH_HEIGHT / SYSFONT_TEXHEIGHT;
+
+	int First = arrlen(GDebug.TextVertices);
+	arrput(GDebug.TextVertices, ((SDL_Vertex){{X, Y}, Color, {U0, V0}}));
+	arrput(GDebug.TextVertices, ((SDL_Vertex){{X + DEBUG_GLYPH_WIDTH, Y}, Color, {U1, V0}}));
+	arrput(GDebug.TextVertices, ((SDL_Vertex){{X + DEBUG_GLYPH_WIDTH, Y + DEBUG_GLYPH_HEIGHT}, Color, {U1, V1}}));
+	arrput(GDebug.TextVertices, ((SDL_Vertex){{X, Y + DEBUG_GLYPH_HEIGHT}, Color, {U0, V1}}));
+
+	int Quad[6] = {First, First + 1, First + 2, First, First + 2, First + 3};
+	for (int32 Index = 0; Index < 6; Index++) {
+		arrput(GDebug.TextIndices, Quad[Index]);
+	}
+}
+
+// Same output as SDL_snprintf for the recorded call, see LogFormatArgs.
+static int32 DebugFormat(const DebugTextCommand* Command, char* Buffer, int32 Size)
 {
-	for (int32 RawIndex = 0; RawIndex < ARRAY_COUNT(GDebug.LinesRingBuffer); RawIndex++) {
-		int32 Index =
-			(GDebug.LinesRingIndex + ARRAY_COUNT(GDebug.LinesRingBuffer)) % ARRAY_COUNT(GDebug.LinesRingBuffer);
-		Index = RawIndex;
-		if (GDebug.LinesRingBuffer[Index].FramesRemaining != 0) {
-			SDL_Color color = GDebug.LinesRingBuffer[Index].Color;
-			SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-			SDL_RenderLines(renderer, GDebug.LinesRingBuffer[Index].Points, GDebug.LinesRingBuffer[Index].PointCount);
+	LogArg Args[DEBUG_MAX_ARGS];
+	int32 ArgCount = SDL_min(Command->ArgCount, (int32)ARRAY_COUNT(Args));
+	for (int32 Index = 0; Index < ArgCount; Index++) {
+		Args[Index] = GDebug.TextArgs[Command->FirstArg + Index];
+		if (Args[Index].Type == LogArgType_String) {
+			Args[Index].String = GDebug.TextStrings + Args[Index].Int;
 		}
 	}
+	return LogFormatArgs(Buffer, Size, Command->Format, Args, ArgCount);
+}
+
+static void DebugBuildText(void)
+{
+	arrsetlen(GDebug.TextVertices, 0);
+	arrsetlen(GDebug.TextIndices, 0);
 
-	if (GDebug.CanvasTexture == NULL) {
-		GDebug.CanvasTexture = SDL_CreateTexture(
+	SDL_FColor Color;
+	{
+		uint8 R, G, B, A;
+		SDL_GetRGBA(GDebug.ForegroundColor, SDL_GetPixelFormatDetails(SDL_PIXELFORMAT_RGBA32), NULL, &R, &G, &B, &A);
+		Color = (SDL_FColor){R / 255.0f, G / 255.0f, B / 255.0f, A / 255.0f};
+	}
+
+	GDebug.CanvasFrameRect.w = 0;
+	for (int32 CommandIndex = 0; CommandIndex < arrlen(GDebug.TextCommands); CommandIndex++) {
+		const DebugTextCommand* Command = &GDebug.TextCommands[CommandIndex];
+		char Buffer[1024];
+		int32 Length = DebugFormat(Command, Buffer, ARRAY_COUNT(Buffer));
+
+		for (int32 Index = 0; Index < Length; Index++) {
+			if (Buffer[Index] != ' ') {
+				float X = Command->Position.x + Index * DEBUG_GLYPH_WIDTH;
+				DebugAddGlyph((uint8)Buffer[Index], X, Command->Position.y, Color);
+			}
+		}
+
+		int32 StringWidth = Length * DEBUG_GLYPH_WIDTH + GDebug.Margin * 2;
+		GDebug.CanvasFrameRect.w = SDL_max(GDebug.CanvasFrameRect.w, StringWidth);
+	}
+
+	GDebug.TextValid = true;
+}
+
+void DebugDraw(SDL_Renderer* renderer)
+{
+	if (arrlen(GDebug.Segments) > 0) {
+		if (!GDebug.GeometryValid) {
+			DebugBuildGeometry();
+		}
+		SDL_RenderGeometry(
 			renderer,
-			GDebug.Canvas->format,
-			SDL_TEXTUREACCESS_STREAMING,
-			GDebug.Canvas->w,
-			GDebug.Canvas->h);
-		SDL_SetTextureScaleMode(GDebug.CanvasTexture, SDL_SCALEMODE_NEAREST);
-		SDL_SetTextureBlendMode(GDebug.CanvasTexture, SDL_BLENDMODE_BLEND);
-	}
-
-	SDL_Surface* CanvasTextureSurface;
-	if (SDL_LockTextureToSurface(GDebug.CanvasTexture, NULL, &CanvasTextureSurface)) {
-		SDL_Rect IntRect = (SDL_Rect){
-			(int)GDebug.CanvasFrameRect.x,
-			(int)GDebug.CanvasFrameRect.y,
-			(int)GDebug.CanvasFrameRect.w,
-			(int)GDebug.CanvasFrameRect.h,
-		};
-		SDL_FillSurfaceRect(CanvasTextureSurface, &GDebug.CanvasFrameRect, 0x00000000);
-		SDL_BlitSurface(GDebug.Canvas, &GDebug.CanvasFrameRect, CanvasTextureSurface, &GDebug.CanvasFrameRect);
-		SDL_UnlockTexture(GDebug.CanvasTexture);
+			NULL,
+			GDebug.Vertices,
+			arrlen(GDebug.Vertices),
+			GDebug.Indices,
+			arrlen(GDebug.Indices));
+	}
+
+	if (arrlen(GDebug.TextCommands) == 0) {
+		return;
+	}
+	if (!GDebug.TextValid) {
+		DebugBuildText();
 	}
 
 	SDL_FRect CanvasFrameFRect;
 	SDL_RectToFRect(&GDebug.CanvasFrameRect, &CanvasFrameFRect);
 
-	const SDL_PixelFormatDetails* FormatDetails = SDL_GetPixelFormatDetails(GDebug.Canvas->format);
+	const SDL_PixelFormatDetails* FormatDetails = SDL_GetPixelFormatDetails(SDL_PIXELFORMAT_RGBA32);
 	{
 		uint8 R, G, B, A;
 		SDL_GetRGBA(GDebug.BackgroundColor, FormatDetails, NULL, &R, &G, &B, &A);
@@ -120,55 +292,46 @@ void DebugDraw(SDL_Renderer* renderer)
 	}
 	SDL_RenderRect(renderer, &CanvasFrameFRect);
 
-	SDL_RenderTexture(renderer, GDebug.CanvasTexture, &CanvasFrameFRect, &CanvasFrameFRect);
+	if (arrlen(GDebug.TextIndices) > 0) {
+		SDL_RenderGeometry(
+			renderer,
+			DebugGetAtlas(renderer),
+			GDebug.TextVertices,
+			arrlen(GDebug.TextVertices),
+			GDebug.TextIndices,
+			arrlen(GDebug.TextIndices));
+	}
 }
 
-static int32 NextIndex()
+#if DEBUG_OVERLAY
+static void DebugAddSegment(float x0, float y0, float x1, float y1, Color color, int frames)
 {
-	int32 Index = GDebug.LinesRingIndex;
-	GDebug.LinesRingIndex++;
-	if (GDebug.LinesRingIndex >= ARRAY_COUNT(GDebug.LinesRingBuffer)) {
-		GDebug.LinesRingIndex = 0;
-	}
-	return Index;
+	arrput(
+		GDebug.Segments,
+		((DebugSegment){
+			.From = {x0, y0},
+			.To = {x1, y1},
+			.Color = {color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f},
+			.FramesRemaining = SDL_max(frames, 1),
+		}));
+	GDebug.GeometryValid = false;
 }
 
 void DebugLine(float x0, float y0, float x1, float y1, Color color, int frames)
 {
-#if 0
-#define line(index) g_debug.lines_ring_buffer[index]
-#define line_point(index, point) line(index).points[point]
-	int32 index= NextIndex();
-	line(index).FramesRemaining= frames;
-	line(index).PointCount= 2;
-	line(index).color= *((SDL_Color*)&color);
-	world_fpoint_to_screen_point(x0, y0, &line_point(index, 0).x, &line_point(index, 0).y);
-	world_fpoint_to_screen_point(x1, y1, &line_point(index, 1).x, &line_point(index, 1).y);
-#undef line_point
-#undef line
-#endif
+	DebugAddSegment(x0, y0, x1, y1, color, frames);
 }
 
 void DebugBox(float x0, float y0, float x1, float y1, Color color, int frames)
 {
-#if 0
-#define line(index) g_debug.lines_ring_buffer[index]
-#define line_point(index, point) line(index).points[point]
-	int32 index= NextIndex();
-	line(index).FramesRemaining= frames;
-	line(index).PointCount= 5;
-	line(index).color= *((SDL_Color*)&color);
-
-	world_fpoint_to_screen_point(x0, y0, &line_point(index, 0).x, &line_point(index, 0).y);
-	world_fpoint_to_screen_point(x1, y0, &line_point(index, 1).x, &line_point(index, 1).y);
-	world_fpoint_to_screen_point(x1, y1, &line_point(index, 2).x, &line_point(index, 2).y);
-	world_fpoint_to_screen_point(x0, y1, &line_point(index, 3).x, &line_point(index, 3).y);
-	world_fpoint_to_screen_point(x0, y0, &line_point(index, 4).x, &line_point(index, 4).y);
-#undef line_point
-#undef line
-#endif
+	DebugAddSegment(x0, y0, x1, y0, color, frames);
+	DebugAddSegment(x1, y0, x1, y1, color, frames);
+	DebugAddSegment(x1, y1, x0, y1, color, frames);
+	DebugAddSegment(x0, y1, x0, y0, color, frames);
 }
 
+#endif
+
 void DebugSetCursorXY(int32 x, int32 y)
 {
 	GDebug.CursorPos.x = x;
@@ -181,32 +344,33 @@ void DebugGetCursorXY(int32* x, int32* y)
 	if (y) *y = GDebug.CursorPos.y;
 }
 
-void DebugPrintf(const char* format, ...)
+#if DEBUG_OVERLAY
+void DebugPrintfArgs(const char* Format, const LogArg* Args, int32 ArgCount)
 {
-	enum { KCharWidth = 9, KLineHeight = 16 };
-
-	char Buffer[1024];
-	va_list Args;
-	va_start(Args, format);
-	SDL_vsnprintf(Buffer, ARRAY_COUNT(Buffer), format, Args);
-	va_end(Args);
-
-	sysfont_9x16_u32(
-		GDebug.Canvas->pixels,
-		GDebug.Canvas->w,
-		GDebug.Canvas->h,
-		GDebug.CursorPos.x + GDebug.Margin,
-		GDebug.CursorPos.y + GDebug.Margin,
-		Buffer,
-		GDebug.ForegroundColor);
-
-	GDebug.CursorPos.x = 0;
-	GDebug.CursorPos.y += KLineHeight;
+	DebugTextCommand Command = {
+		.Format = Format,
+		.FirstArg = arrlen(GDebug.TextArgs),
+		.ArgCount = ArgCount,
+		.Position = {GDebug.CursorPos.x + GDebug.Margin, GDebug.CursorPos.y + GDebug.Margin},
+	};
 
-	size_t Length = SDL_strnlen(Buffer, SDL_arraysize(Buffer));
-	int StringWidth = Length * KCharWidth + GDebug.Margin * 2;
-	if (StringWidth > GDebug.CanvasFrameRect.w) {
-		GDebug.CanvasFrameRect.w = StringWidth;
+	for (int32 Index = 0; Index < ArgCount; Index++) {
+		LogArg Arg = Args[Index];
+		if (Arg.Type == LogArgType_String) {
+			const char* String = (Arg.String != NULL) ? Arg.String : "(null)";
+			size_t Offset = arrlen(GDebug.TextStrings);
+			size_t Bytes = SDL_strlen(String) + 1;
+			arrsetlen(GDebug.TextStrings, Offset + Bytes);
+			SDL_memcpy(GDebug.TextStrings + Offset, String, Bytes);
+			Arg.Int = (int64)Offset;
+		}
+		arrput(GDebug.TextArgs, Arg);
 	}
-	GDebug.CanvasFrameRect.h += KLineHeight;
+	arrput(GDebug.TextCommands, Command);
+	GDebug.TextValid = false;
+
+	GDebug.CursorPos.x = 0;
+	GDebug.CursorPos.y += DEBUG_GLYPH_HEIGHT;
+	GDebug.CanvasFrameRect.h += DEBUG_GLYPH_HEIGHT;
 }
+#endif
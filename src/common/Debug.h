@@ -1,7 +1,19 @@
 #pragma once
 
+#include "Log.h"
 #include "Types.h"
 
+// The overlay's drawing calls are compiled in for debug builds only, build with DEBUG_OVERLAY=1 to keep them in
+// release. When compiled out DebugLine, DebugBox and DebugPrintf expand to nothing and their arguments aren't
+// evaluated.
+#ifndef DEBUG_OVERLAY
+#ifdef _DEBUG
+#define DEBUG_OVERLAY 1
+#else
+#define DEBUG_OVERLAY 0
+#endif
+#endif
+
 typedef struct SDL_Renderer SDL_Renderer;
 typedef struct SDL_FRect SDL_FRect;
 
@@ -9,6 +21,8 @@ typedef struct Color {
 	uint8 r, g, b, a;
 } Color;
 
+// Text is drawn from a glyph atlas uploaded once per renderer, the canvas size only clips it. Colours are
+// SDL_PIXELFORMAT_RGBA32 values.
 typedef struct DebugConfig {
 	int32 CanvasWidth, CanvasHeight;
 	SDL_Renderer* Renderer;
@@ -23,9 +37,21 @@ void DebugShutdown(void);
 void DebugNextFrame(void);
 void DebugDraw(SDL_Renderer* renderer);
 
+void DebugSetCursorXY(int32 x, int32 y);
+void DebugGetCursorXY(int32* x, int32* y);
+
+#if DEBUG_OVERLAY
+// Renderer coordinates. Shown by the next frames calls to DebugDraw, at least one, all batched into a single draw.
 void DebugLine(float x0, float y0, float x1, float y1, Color color, int frames);
 void DebugBox(float x0, float y0, float x1, float y1, Color color, int frames);
 
-void DebugSetCursorXY(int32 x, int32 y);
-void DebugGetCursorXY(int32* x, int32* y);
-void DebugPrintf(const char* format, ...);
\ No newline at end of file
+// Arguments are captured as LogArg by value, strings copied, and only formatted by LogFormatArgs when DebugDraw runs.
+// Format has to be a string literal, it is kept by pointer. * widths and precisions aren't supported.
+void DebugPrintfArgs(const char* Format, const LogArg* Args, int32 ArgCount);
+#define DebugPrintf(Format, ...)                                                                                       \
+	DebugPrintfArgs("" Format, LOG_ARG_LIST(__VA_ARGS__) + 1, ARRAY_COUNT(LOG_ARG_LIST(__VA_ARGS__)) - 1)
+#else
+#define DebugLine(...) ((void)0)
+#define DebugBox(...) ((void)0)
+#define DebugPrintf(...) ((void)0)
+#endif
\ No newline at end of file
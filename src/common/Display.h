@@ -2,6 +2,7 @@
 
 #include <SDL3/SDL.h>
 
+#include "ShaveCoverage.h"
 #include "Types.h"
 
 typedef struct RazorState RazorState;
@@ -10,6 +11,9 @@ typedef struct Application Application;
 typedef struct Display {
 	int32 Width;
 	int32 Height;
+	ShaveCoverage Coverage;
 } Display;
 
-Display *GetDisplayForRazor(Application *App, RazorState *Razor);
\ No newline at end of file
+Display *GetDisplayForRazor(Application *App, RazorState *Razor);
+// Fills the razor's lane down to its current position right away, for strokes that end inside an interpolator callback.
+void FillRazorLane(Application *App, RazorState *Razor);
\ No newline at end of file
@@ -1,74 +1,241 @@
 #include "FrameAllocator.h"
 
-#include <stb_ds.h>
-#include <stdlib.h>
+#include <SDL3/SDL_atomic.h>
 
 #include "Log.h"
+#include "MemoryTracker.h"
 
-struct Allocation {
-	void* key;
-	bool value;
-};
+#if FRAME_ALLOCATOR_TRACKING
+#define FRAME_ALLOC_LIVE 0xF7A1
+#define FRAME_ALLOC_FREED 0xDEAD
+#define FRAME_ALLOC_RELEASED 0xBEEF
+#define FRAME_ALLOC_NO_HEADER SIZE_MAX
+
+// Sits right before every allocation. Prev chains the headers backwards so a marker restore can find the allocations
+// it releases.
+typedef struct FrameAllocHeader {
+	size_t Prev;
+	uint32 Frame;
+	uint16 ArenaIndex;
+	uint16 State;
+} FrameAllocHeader;
+_Static_assert(sizeof(FrameAllocHeader) == 16, "");
+#endif
+
+typedef struct FrameArena {
+	uint8* Memory;
+	size_t Head;
+	size_t HighWaterMark;
+	uint32 Frame; // Frame the arena was last rewound for, owned by its thread.
+	int32 Index;
+#if FRAME_ALLOCATOR_TRACKING
+	size_t LastHeader;
+	SDL_AtomicInt Outstanding;
+#endif
+} FrameArena;
 
 struct {
-	void* Memory;
-	struct Allocation* TrackedAllocations;
-	uint64 Head;
-	uint64 Capacity;
-	uint64 HighWaterMark;
+	FrameArena* Arenas[FRAME_ALLOCATOR_MAX_THREADS];
+	SDL_AtomicInt ArenaCount;
+	SDL_AtomicInt Frame;
+	size_t Capacity;
+	uint32 Instance; // Bumped by every initialize so thread-local arena pointers from before a shutdown are dropped.
 } GFrameAlloc;
 
+static _Thread_local struct {
+	FrameArena* Arena;
+	uint32 Instance;
+} TFrameArena;
+
 void FrameAllocatorInitialize(size_t Size)
 {
+	uint32 Instance = GFrameAlloc.Instance;
 	ZERO_STRUCT(&GFrameAlloc);
 	GFrameAlloc.Capacity = Size;
-	GFrameAlloc.Memory = malloc(GFrameAlloc.Capacity);
-
-	hmdefault(GFrameAlloc.TrackedAllocations, false);
-
-	ASSERT(GFrameAlloc.Memory);
+	GFrameAlloc.Instance = Instance + 1;
 }
 
 void FrameAllocatorShutdown(void)
 {
-	free(GFrameAlloc.Memory);
-	hmfree(GFrameAlloc.TrackedAllocations);
+	int32 ArenaCount = SDL_min(SDL_GetAtomicInt(&GFrameAlloc.ArenaCount), FRAME_ALLOCATOR_MAX_THREADS);
+	for (int32 Index = 0; Index < ArenaCount; Index++) {
+		FrameArena* Arena = SDL_GetAtomicPointer((void**)&GFrameAlloc.Arenas[Index]);
+		if (Arena) {
+			MemoryFree(Arena->Memory);
+			MemoryFree(Arena);
+		}
+	}
+
+	uint32 Instance = GFrameAlloc.Instance;
 	ZERO_STRUCT(&GFrameAlloc);
+	GFrameAlloc.Instance = Instance + 1;
 }
 
 void FrameAllocatorNextFrame(void)
 {
-	ASSERT(hmlen(GFrameAlloc.TrackedAllocations) == 0 && "All frame allocations must be freed with call to FrameFree before next frame.");
-	ASSERT(GFrameAlloc.Memory);
-	if (GFrameAlloc.Head > GFrameAlloc.HighWaterMark)
-	{
-		GFrameAlloc.HighWaterMark = GFrameAlloc.Head;
-		LogWarning("FrameAllocator: New high water mark of %llu bytes", GFrameAlloc.HighWaterMark);
+	ASSERT(GFrameAlloc.Capacity > 0);
+#if FRAME_ALLOCATOR_TRACKING
+	int32 ArenaCount = SDL_min(SDL_GetAtomicInt(&GFrameAlloc.ArenaCount), FRAME_ALLOCATOR_MAX_THREADS);
+	for (int32 Index = 0; Index < ArenaCount; Index++) {
+		FrameArena* Arena = SDL_GetAtomicPointer((void**)&GFrameAlloc.Arenas[Index]);
+		// Nothing may allocate for the ending frame any more and the new one hasn't started, so the count can be
+		// taken and cleared here. Each leak is reported once.
+		int32 Leaked = Arena ? SDL_SetAtomicInt(&Arena->Outstanding, 0) : 0;
+		ASSERT(Leaked == 0 && "All frame allocations must be freed with call to FrameFree before next frame.");
 	}
-	GFrameAlloc.Head = 0;
+#endif
+	SDL_AddAtomicInt(&GFrameAlloc.Frame, 1);
 }
 
-void* FrameAlloc(size_t Size)
+static void FrameArenaRewind(FrameArena* Arena, uint32 Frame)
 {
-	ASSERT(GFrameAlloc.Head + Size <= GFrameAlloc.Capacity);
+	if (Arena->Head > Arena->HighWaterMark) {
+		Arena->HighWaterMark = Arena->Head;
+		LogWarning(
+			"FrameAllocator: New high water mark of %llu bytes in arena %d",
+			(unsigned long long)Arena->HighWaterMark,
+			Arena->Index);
+	}
+	Arena->Head = 0;
+	Arena->Frame = Frame;
+#if FRAME_ALLOCATOR_TRACKING
+	Arena->LastHeader = FRAME_ALLOC_NO_HEADER;
+#endif
+}
 
-	void* Result = NULL;
+// The calling thread's arena, created on first use and rewound on its first use in a new frame.
+static FrameArena* FrameAllocatorGetArena(void)
+{
+	FrameArena* Arena = TFrameArena.Arena;
+	if (!Arena || TFrameArena.Instance != GFrameAlloc.Instance) {
+		ASSERT(GFrameAlloc.Capacity > 0 && "FrameAllocatorInitialize has to be called first.");
+		int32 Index = SDL_AddAtomicInt(&GFrameAlloc.ArenaCount, 1);
+		if (Index >= FRAME_ALLOCATOR_MAX_THREADS) {
+			PanicAndAbort("Frame Allocator Panic", "Too many threads use the frame allocator!");
+		}
+
+		Arena = MemoryAlloc(MemoryTag_FrameArena, sizeof(FrameArena));
+		if (!Arena) {
+			PanicAndAbort("Frame Allocator Panic", "Frame allocator could not allocate its arena!");
+		}
+		ZERO_STRUCT(Arena);
+		Arena->Memory = MemoryAlloc(MemoryTag_FrameArena, GFrameAlloc.Capacity);
+		if (!Arena->Memory) {
+			PanicAndAbort("Frame Allocator Panic", "Frame allocator could not allocate its arena!");
+		}
+		Arena->Index = Index;
+		FrameArenaRewind(Arena, (uint32)SDL_GetAtomicInt(&GFrameAlloc.Frame));
+		SDL_SetAtomicPointer((void**)&GFrameAlloc.Arenas[Index], Arena);
+
+		TFrameArena.Arena = Arena;
+		TFrameArena.Instance = GFrameAlloc.Instance;
+		return Arena;
+	}
 
-	if (GFrameAlloc.Head + Size <= GFrameAlloc.Capacity) {
-		Result = (uint8*)GFrameAlloc.Memory + GFrameAlloc.Head;
-		GFrameAlloc.Head += Size;
+	uint32 Frame = (uint32)SDL_GetAtomicInt(&GFrameAlloc.Frame);
+	if (Arena->Frame != Frame) {
+		FrameArenaRewind(Arena, Frame);
+	}
+	return Arena;
+}
+
+void* FrameAllocAligned(size_t Size, size_t Alignment)
+{
+	ASSERT(Alignment > 0 && (Alignment & (Alignment - 1)) == 0);
+	FrameArena* Arena = FrameAllocatorGetArena();
 
-		hmput(GFrameAlloc.TrackedAllocations, Result, true);
-	} else {
+	size_t Start = Arena->Head;
+#if FRAME_ALLOCATOR_TRACKING
+	Start += sizeof(FrameAllocHeader);
+#endif
+	uintptr_t Base = (uintptr_t)Arena->Memory;
+	size_t Offset = ((Base + Start + Alignment - 1) & ~(uintptr_t)(Alignment - 1)) - Base;
+	ASSERT(Offset + Size <= GFrameAlloc.Capacity);
+	if (Offset + Size > GFrameAlloc.Capacity) {
 		PanicAndAbort("Frame Allocator Panic", "Frame allocator exceeded capacity!");
 	}
 
+	void* Result = Arena->Memory + Offset;
+	Arena->Head = Offset + Size;
+
+#if FRAME_ALLOCATOR_TRACKING
+	size_t HeaderOffset = Offset - sizeof(FrameAllocHeader);
+	FrameAllocHeader Header = {
+		.Prev = Arena->LastHeader,
+		.Frame = Arena->Frame,
+		.ArenaIndex = (uint16)Arena->Index,
+		.State = FRAME_ALLOC_LIVE,
+	};
+	SDL_memcpy(Arena->Memory + HeaderOffset, &Header, sizeof(Header));
+	Arena->LastHeader = HeaderOffset;
+	SDL_AddAtomicInt(&Arena->Outstanding, 1);
+#endif
+
 	return Result;
 }
 
+FrameMarker FrameAllocatorGetMarker(void)
+{
+	FrameArena* Arena = FrameAllocatorGetArena();
+	return (FrameMarker){
+		.Head = Arena->Head,
+#if FRAME_ALLOCATOR_TRACKING
+		.LastHeader = Arena->LastHeader,
+		.Frame = Arena->Frame,
+		.ArenaIndex = Arena->Index,
+#endif
+	};
+}
+
+void FrameAllocatorRestore(FrameMarker Marker)
+{
+	FrameArena* Arena = FrameAllocatorGetArena();
+	ASSERT(Marker.Head <= Arena->Head && "Marker restored twice or out of order.");
+
+#if FRAME_ALLOCATOR_TRACKING
+	ASSERT(Marker.ArenaIndex == Arena->Index && "Marker restored on a different thread than it was taken on.");
+	ASSERT(Marker.Frame == Arena->Frame && "Marker restored in a later frame than it was taken in.");
+
+	// Allocations released here no longer need a FrameFree.
+	int32 Released = 0;
+	size_t HeaderOffset = Arena->LastHeader;
+	while (HeaderOffset != Marker.LastHeader && HeaderOffset != FRAME_ALLOC_NO_HEADER) {
+		FrameAllocHeader* Header = (FrameAllocHeader*)(Arena->Memory + HeaderOffset);
+		Released += Header->State == FRAME_ALLOC_LIVE;
+		Header->State = FRAME_ALLOC_RELEASED;
+		HeaderOffset = Header->Prev;
+	}
+	SDL_AddAtomicInt(&Arena->Outstanding, -Released);
+	Arena->LastHeader = Marker.LastHeader;
+#endif
+
+	Arena->Head = Marker.Head;
+}
+
+#if FRAME_ALLOCATOR_TRACKING
 void FrameFree(void* Pointer)
 {
-	bool IsTrackedAllocation = hmgeti(GFrameAlloc.TrackedAllocations, Pointer) >= 0;
-	ASSERT(IsTrackedAllocation);
-	hmdel(GFrameAlloc.TrackedAllocations, Pointer);
-}
\ No newline at end of file
+	if (!Pointer) {
+		return;
+	}
+
+	FrameAllocHeader* Header = (FrameAllocHeader*)Pointer - 1;
+	bool CurrentFrame = Header->Frame == (uint32)SDL_GetAtomicInt(&GFrameAlloc.Frame);
+	ASSERT(Header->State != FRAME_ALLOC_FREED && "Frame allocation freed twice.");
+	ASSERT(Header->State != FRAME_ALLOC_RELEASED && "Frame allocation was already released by a marker.");
+	ASSERT(
+		(Header->State == FRAME_ALLOC_LIVE || Header->State == FRAME_ALLOC_FREED ||
+		 Header->State == FRAME_ALLOC_RELEASED) &&
+		"Not a frame allocation.");
+	ASSERT(CurrentFrame && "Frame allocation freed in a later frame than it was made in.");
+
+	// Arenas from earlier frames have already been rewound, or will be, and drop their counts.
+	if (Header->State == FRAME_ALLOC_LIVE && CurrentFrame && Header->ArenaIndex < FRAME_ALLOCATOR_MAX_THREADS) {
+		FrameArena* Arena = SDL_GetAtomicPointer((void**)&GFrameAlloc.Arenas[Header->ArenaIndex]);
+		Header->State = FRAME_ALLOC_FREED;
+		if (Arena) {
+			SDL_AddAtomicInt(&Arena->Outstanding, -1);
+		}
+	}
+}
+#endif
@@ -2,9 +2,53 @@
 
 #include "Types.h"
 
+// Bump allocator for memory that only lives until the end of the frame. Each thread allocates from its own arena,
+// created on first use, so FrameAlloc is safe from jobs without locking. FrameAllocatorNextFrame releases every arena
+// at once, each is rewound the next time its thread allocates.
+//
+// Tracking is compiled into debug builds only, build with FRAME_ALLOCATOR_TRACKING=1 to keep it in release. It
+// checks that every allocation is passed to FrameFree before the next frame, catches frees of memory from an earlier
+// frame or already released by a marker, and costs a 16 byte header per allocation. Without it FrameFree is a no-op.
+#ifndef FRAME_ALLOCATOR_TRACKING
+#ifdef _DEBUG
+#define FRAME_ALLOCATOR_TRACKING 1
+#else
+#define FRAME_ALLOCATOR_TRACKING 0
+#endif
+#endif
+
+#define FRAME_ALLOC_DEFAULT_ALIGNMENT 16
+#define FRAME_ALLOCATOR_MAX_THREADS 64
+
+typedef struct FrameMarker {
+	size_t Head;
+#if FRAME_ALLOCATOR_TRACKING
+	size_t LastHeader;
+	uint32 Frame;
+	int32 ArenaIndex;
+#endif
+} FrameMarker;
+
+// Size is the capacity of each thread's arena.
 void FrameAllocatorInitialize(size_t Size);
 void FrameAllocatorShutdown(void);
+// Call from the main thread. Memory handed out before this call must not be used afterwards, from any thread.
 void FrameAllocatorNextFrame(void);
 
-void* FrameAlloc(size_t Size);
-void FrameFree(void* Pointer);
\ No newline at end of file
+// Alignment must be a power of two.
+void* FrameAllocAligned(size_t Size, size_t Alignment);
+static inline void* FrameAlloc(size_t Size)
+{
+	return FrameAllocAligned(Size, FRAME_ALLOC_DEFAULT_ALIGNMENT);
+}
+
+// Restoring a marker releases everything the calling thread allocated after taking it, without FrameFree. Markers
+// nest and only apply to the thread and frame they were taken on.
+FrameMarker FrameAllocatorGetMarker(void);
+void FrameAllocatorRestore(FrameMarker Marker);
+
+#if FRAME_ALLOCATOR_TRACKING
+void FrameFree(void* Pointer);
+#else
+#define FrameFree(Pointer) ((void)(Pointer))
+#endif
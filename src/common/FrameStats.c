@@ -0,0 +1,100 @@
+#include "FrameStats.h"
+
+#include <SDL3/SDL.h>
+#include <sokol_time.h>
+
+static struct {
+	uint64 Current[FramePhase_Count];
+	float32 History[FRAME_STATS_HISTORY][FramePhase_Count]; // Milliseconds
+	int32 Next;
+	int32 Count;
+} GFrameStats;
+
+static const char* PhaseNames[FramePhase_Count] = {
+	[FramePhase_Update] = "UPDATE",
+	[FramePhase_ShaveFill] = "SHAVE FILL",
+	[FramePhase_Upload] = "UPLOAD",
+	[FramePhase_Render] = "RENDER",
+	[FramePhase_Present] = "PRESENT",
+	[FramePhase_Wait] = "WAIT",
+};
+
+void FrameStatsAdd(FramePhase Phase, uint64 Ticks)
+{
+	ASSERT(VALID_INDEX(Phase, FramePhase_Count));
+	GFrameStats.Current[Phase] += Ticks;
+}
+
+void FrameStatsEndFrame(void)
+{
+	uint64* Current = GFrameStats.Current;
+	uint64 UpdateChildren = Current[FramePhase_ShaveFill] + Current[FramePhase_Upload];
+	Current[FramePhase_Update] -= SDL_min(Current[FramePhase_Update], UpdateChildren);
+	Current[FramePhase_Render] -= SDL_min(Current[FramePhase_Render], Current[FramePhase_Present]);
+
+	float32* Frame = GFrameStats.History[GFrameStats.Next];
+	for (int32 Phase = 0; Phase < FramePhase_Count; Phase++) {
+		Frame[Phase] = (float32)stm_ms(Current[Phase]);
+		Current[Phase] = 0;
+	}
+
+	GFrameStats.Next = (GFrameStats.Next + 1) % FRAME_STATS_HISTORY;
+	GFrameStats.Count = SDL_min(GFrameStats.Count + 1, FRAME_STATS_HISTORY);
+}
+
+const char* FrameStatsGetPhaseName(FramePhase Phase)
+{
+	ASSERT(VALID_INDEX(Phase, FramePhase_Count));
+	return PhaseNames[Phase];
+}
+
+int32 FrameStatsGetFrameCount(void)
+{
+	return GFrameStats.Count;
+}
+
+float32 FrameStatsGetPhaseMS(int32 Age, FramePhase Phase)
+{
+	ASSERT(VALID_INDEX(Age, GFrameStats.Count));
+	int32 Index = (GFrameStats.Next - 1 - Age + FRAME_STATS_HISTORY) % FRAME_STATS_HISTORY;
+	return GFrameStats.History[Index][Phase];
+}
+
+static int CompareFloat32(const void* A, const void* B)
+{
+	float32 Left = *(const float32*)A;
+	float32 Right = *(const float32*)B;
+	return (Left > Right) - (Left < Right);
+}
+
+// Nearest rank, so every reported value is a frame that actually happened.
+static float32 Percentile(const float32* Sorted, int32 Count, int32 Percent)
+{
+	int32 Rank = (Count * Percent + 99) / 100;
+	return Sorted[SDL_clamp(Rank - 1, 0, Count - 1)];
+}
+
+void FrameStatsSummarize(FrameStatsSummary* OutSummary)
+{
+	SDL_zerop(OutSummary);
+	OutSummary->FrameCount = GFrameStats.Count;
+	if (GFrameStats.Count == 0) {
+		return;
+	}
+
+	float32 Totals[FRAME_STATS_HISTORY];
+	for (int32 Age = 0; Age < GFrameStats.Count; Age++) {
+		Totals[Age] = 0.0f;
+		for (int32 Phase = 0; Phase < FramePhase_Count; Phase++) {
+			float32 PhaseMS = FrameStatsGetPhaseMS(Age, Phase);
+			Totals[Age] += PhaseMS;
+			OutSummary->PhaseAverage[Phase] += PhaseMS / GFrameStats.Count;
+		}
+	}
+
+	SDL_qsort(Totals, GFrameStats.Count, sizeof(float32), CompareFloat32);
+	OutSummary->P50 = Percentile(Totals, GFrameStats.Count, 50);
+	OutSummary->P95 = Percentile(Totals, GFrameStats.Count, 95);
+	OutSummary->P99 = Percentile(Totals, GFrameStats.Count, 99);
+	OutSummary->Worst = Totals[GFrameStats.Count - 1];
+}
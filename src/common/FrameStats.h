@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Types.h"
+
+// Per phase timings of the last FRAME_STATS_HISTORY frames. Phases add up to the whole frame, nested ones (shave fill
+// and upload inside update, present inside render) are taken out of their parent when the frame ends. Recording is a
+// handful of adds per frame, summaries are only computed when asked for. Main thread only.
+
+#define FRAME_STATS_HISTORY 240
+
+typedef enum FramePhase {
+	FramePhase_Update,
+	FramePhase_ShaveFill,
+	FramePhase_Upload,
+	FramePhase_Render,
+	FramePhase_Present,
+	FramePhase_Wait,
+	FramePhase_Count,
+} FramePhase;
+
+typedef struct FrameStatsSummary {
+	int32 FrameCount;
+	float32 P50, P95, P99, Worst; // Whole frame, milliseconds
+	float32 PhaseAverage[FramePhase_Count];
+} FrameStatsSummary;
+
+// Ticks are sokol_time ticks, adding to a phase more than once per frame accumulates.
+void FrameStatsAdd(FramePhase Phase, uint64 Ticks);
+void FrameStatsEndFrame(void);
+
+const char* FrameStatsGetPhaseName(FramePhase Phase);
+int32 FrameStatsGetFrameCount(void);
+// Age 0 is the most recently ended frame.
+float32 FrameStatsGetPhaseMS(int32 Age, FramePhase Phase);
+void FrameStatsSummarize(FrameStatsSummary* OutSummary);
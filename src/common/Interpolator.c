@@ -1,14 +1,11 @@
 #include "Interpolator.h"
 
-#include <stb_ds.h>
-
 #include "Debug.h"
 #include "Log.h"
 
-typedef struct InterpolatorContext {
-	Interpolator* Interpolators;
-	handint NextInterpolatorId;
-} InterpolatorContext;
+// Live interpolators per context. Razors keep one each, two for the update where one finishes and its callback
+// starts the next, so this is far more than any display layout needs.
+#define INTERPOLATOR_CAPACITY 256
 
 typedef struct Interpolator {
 	InterpolatorFunction Function;
@@ -23,6 +20,14 @@ typedef struct Interpolator {
 	uint32 Flags;
 } Interpolator;
 
+// A fixed pool, creating an interpolator never allocates and finish callbacks can create new ones while the update
+// still holds pointers into it.
+typedef struct InterpolatorContext {
+	Interpolator Interpolators[INTERPOLATOR_CAPACITY];
+	int32 Count;
+	handint NextInterpolatorId;
+} InterpolatorContext;
+
 const Interpolator* GetInterpolatorConst(const InterpolatorContext* Context, InterpolatorHandle Handle);
 Interpolator* GetInterpolator(const InterpolatorContext* Context, InterpolatorHandle Handle);
 
@@ -32,20 +37,18 @@ InterpolatorContext* CreateInterpolatorContext()
 	SDL_zerop(Context);
 
 	Context->NextInterpolatorId = 1;
-	arrsetcap(Context->Interpolators, 64);
 
 	return Context;
 }
 
 void DestroyInterpolatorContext(InterpolatorContext* Context)
 {
-	arrfree(Context->Interpolators);
 	SDL_free(Context);
 }
 
 void InterpolatorContextUpdate(InterpolatorContext* Context, float32 DeltaTime)
 {
-	for (int InterpolatorIndex = 0, InterpolatorCount = arrlen(Context->Interpolators);
+	for (int InterpolatorIndex = 0, InterpolatorCount = Context->Count;
 		 InterpolatorIndex < InterpolatorCount;
 		 InterpolatorIndex++)
 	{
@@ -62,10 +65,10 @@ void InterpolatorContextUpdate(InterpolatorContext* Context, float32 DeltaTime)
 		}
 	}
 
-	for (int InterpolatorIndex = arrlen(Context->Interpolators) - 1; InterpolatorIndex >= 0; InterpolatorIndex--) {
+	for (int InterpolatorIndex = Context->Count - 1; InterpolatorIndex >= 0; InterpolatorIndex--) {
 		Interpolator* Interp = &Context->Interpolators[InterpolatorIndex];
 		if ((Interp->Flags & InterpolatorFlags_Destroy) != 0) {
-			arrdelswap(Context->Interpolators, InterpolatorIndex);
+			*Interp = Context->Interpolators[--Context->Count];
 		}
 		if (InterpolatorIndex == 0) {
 			DebugPrintf("INTERP: %0.3f/%0.3f", Interp->Time, Interp->Duration);
@@ -84,12 +87,13 @@ Interpolator* GetInterpolator(const InterpolatorContext* Context, InterpolatorHa
 		return NULL;
 	}
 
-	for (int Index = 0; Index < arrlen(Context->Interpolators); Index++) {
-		Interpolator* Interp = &Context->Interpolators[Index];
+	for (int Index = 0; Index < Context->Count; Index++) {
+		Interpolator* Interp = (Interpolator*)&Context->Interpolators[Index];
 		if (HANDLE_EQ(Interp->Id, Handle)) {
 			return Interp;
 		}
 	}
+	return NULL;
 }
 
 float32 EvalInterpolator(const InterpolatorContext* Context, InterpolatorHandle Handle)
@@ -111,20 +115,24 @@ InterpolatorHandle CreateInterpolator(
 	InterpolatorOnFinish OnFinish,
 	void* UserData)
 {
+	if (Context->Count == INTERPOLATOR_CAPACITY) {
+		LogError("Interpolator: All %d interpolators are in use", INTERPOLATOR_CAPACITY);
+		ASSERT(false && "Interpolator pool exhausted, raise INTERPOLATOR_CAPACITY.");
+		return INVALID_HANDLE(InterpolatorHandle);
+	}
+
 	InterpolatorHandle Id = (InterpolatorHandle){Context->NextInterpolatorId++};
-	arrput(
-		Context->Interpolators,
-		((Interpolator){
-			.Id = Id,
-			.Function = Func,
-			.OnFinish = OnFinish,
-			.Flags = InterpolatorFlags_None,
-			.Start = Start,
-			.Final = Final,
-			.Duration = Duration,
-			.TimeScale = 1.0f,
-			.UserData = UserData,
-		}));
+	Context->Interpolators[Context->Count++] = (Interpolator){
+		.Id = Id,
+		.Function = Func,
+		.OnFinish = OnFinish,
+		.Flags = InterpolatorFlags_None,
+		.Start = Start,
+		.Final = Final,
+		.Duration = Duration,
+		.TimeScale = 1.0f,
+		.UserData = UserData,
+	};
 	return Id;
 }
 
@@ -0,0 +1,219 @@
+#include "Jobs.h"
+
+#include <SDL3/SDL.h>
+
+#include "Log.h"
+
+enum { KJobQueueCapacity = 256, KMaxJobWorkers = 32 };
+
+typedef struct Job {
+	JobFunction Function;
+	void* UserData;
+	JobCounter* Counter;
+} Job;
+
+static struct {
+	SDL_Thread* Workers[KMaxJobWorkers];
+	int32 WorkerCount;
+	SDL_Mutex* Mutex;
+	SDL_Condition* JobAvailable;
+	SDL_Condition* JobFinished;
+	Job Queue[KJobQueueCapacity];
+	int32 QueueHead;
+	int32 QueueCount;
+	bool RequestShutdown;
+} GJobs;
+
+// Expects GJobs.Mutex to be held.
+static bool PopJob(Job* OutJob)
+{
+	if (GJobs.QueueCount == 0) {
+		return false;
+	}
+	*OutJob = GJobs.Queue[GJobs.QueueHead];
+	GJobs.QueueHead = (GJobs.QueueHead + 1) % KJobQueueCapacity;
+	GJobs.QueueCount--;
+	return true;
+}
+
+// Takes the oldest queued job counted by Counter, leaving the others in order. Expects GJobs.Mutex to be held.
+static bool PopJobFor(const JobCounter* Counter, Job* OutJob)
+{
+	for (int32 Index = 0; Index < GJobs.QueueCount; Index++) {
+		int32 Slot = (GJobs.QueueHead + Index) % KJobQueueCapacity;
+		if (GJobs.Queue[Slot].Counter != Counter) {
+			continue;
+		}
+		*OutJob = GJobs.Queue[Slot];
+		for (int32 Later = Index + 1; Later < GJobs.QueueCount; Later++) {
+			int32 LaterSlot = (GJobs.QueueHead + Later) % KJobQueueCapacity;
+			GJobs.Queue[Slot] = GJobs.Queue[LaterSlot];
+			Slot = LaterSlot;
+		}
+		GJobs.QueueCount--;
+		return true;
+	}
+	return false;
+}
+
+// Expects GJobs.Mutex to be held.
+static bool PushJob(const Job* NewJob)
+{
+	if (GJobs.QueueCount >= KJobQueueCapacity || GJobs.WorkerCount == 0) {
+		return false;
+	}
+	GJobs.Queue[(GJobs.QueueHead + GJobs.QueueCount) % KJobQueueCapacity] = *NewJob;
+	GJobs.QueueCount++;
+	SDL_SignalCondition(GJobs.JobAvailable);
+	return true;
+}
+
+static void RunJob(const Job* RunningJob)
+{
+	RunningJob->Function(RunningJob->UserData);
+
+	if (RunningJob->Counter != NULL && SDL_AddAtomicInt(&RunningJob->Counter->Pending, -1) == 1) {
+		// Taking the lock orders this wake up after any waiter's check of the counter so it can't be missed.
+		SDL_LockMutex(GJobs.Mutex);
+		SDL_BroadcastCondition(GJobs.JobFinished);
+		SDL_UnlockMutex(GJobs.Mutex);
+	}
+}
+
+static int JobWorkerMain(void* UserData)
+{
+	for (;;) {
+		Job NextJob;
+
+		SDL_LockMutex(GJobs.Mutex);
+		while (GJobs.QueueCount == 0 && !GJobs.RequestShutdown) {
+			SDL_WaitCondition(GJobs.JobAvailable, GJobs.Mutex);
+		}
+		bool HasJob = PopJob(&NextJob);
+		SDL_UnlockMutex(GJobs.Mutex);
+
+		if (!HasJob) {
+			break;
+		}
+
+		RunJob(&NextJob);
+	}
+
+	return 0;
+}
+
+void JobsInitialize(int32 WorkerCount)
+{
+	ASSERT(GJobs.Mutex == NULL);
+
+	if (WorkerCount <= 0) {
+		WorkerCount = SDL_GetNumLogicalCPUCores() - 1;
+	}
+	WorkerCount = SDL_clamp(WorkerCount, 1, KMaxJobWorkers);
+
+	GJobs.Mutex = SDL_CreateMutex();
+	GJobs.JobAvailable = SDL_CreateCondition();
+	GJobs.JobFinished = SDL_CreateCondition();
+
+	for (int32 WorkerIndex = 0; WorkerIndex < WorkerCount; WorkerIndex++) {
+		char WorkerName[32];
+		SDL_snprintf(WorkerName, SDL_arraysize(WorkerName), "JobWorker_%02d", WorkerIndex);
+		GJobs.Workers[WorkerIndex] = SDL_CreateThread(JobWorkerMain, WorkerName, NULL);
+		if (GJobs.Workers[WorkerIndex] == NULL) {
+			LogWarning("Jobs: Unable to create worker %d: %s", WorkerIndex, SDL_GetError());
+			break;
+		}
+		GJobs.WorkerCount++;
+	}
+
+	LogInfo("Jobs: Started %d worker(s)", GJobs.WorkerCount);
+}
+
+void JobsShutdown(void)
+{
+	SDL_LockMutex(GJobs.Mutex);
+	GJobs.RequestShutdown = true;
+	SDL_BroadcastCondition(GJobs.JobAvailable);
+	SDL_UnlockMutex(GJobs.Mutex);
+
+	for (int32 WorkerIndex = 0; WorkerIndex < GJobs.WorkerCount; WorkerIndex++) {
+		SDL_WaitThread(GJobs.Workers[WorkerIndex], NULL);
+	}
+
+	// Workers drain the queue before exiting, anything left means there were no workers to run it.
+	Job RemainingJob;
+	while (PopJob(&RemainingJob)) {
+		RunJob(&RemainingJob);
+	}
+
+	SDL_DestroyCondition(GJobs.JobFinished);
+	SDL_DestroyCondition(GJobs.JobAvailable);
+	SDL_DestroyMutex(GJobs.Mutex);
+	ZERO_STRUCT(&GJobs);
+}
+
+int32 JobsGetWorkerCount(void)
+{
+	return GJobs.WorkerCount;
+}
+
+void JobsSubmit(JobFunction Function, void* UserData, JobCounter* Counter)
+{
+	ASSERT(Function);
+
+	if (Counter != NULL) {
+		SDL_AddAtomicInt(&Counter->Pending, 1);
+	}
+
+	Job NewJob = {Function, UserData, Counter};
+
+	SDL_LockMutex(GJobs.Mutex);
+	bool Queued = PushJob(&NewJob);
+	SDL_UnlockMutex(GJobs.Mutex);
+
+	if (!Queued) {
+		RunJob(&NewJob);
+	}
+}
+
+bool JobsTrySubmit(JobFunction Function, void* UserData, JobCounter* Counter)
+{
+	ASSERT(Function);
+
+	// Counted before it can run, a worker may finish it before PushJob returns.
+	if (Counter != NULL) {
+		SDL_AddAtomicInt(&Counter->Pending, 1);
+	}
+
+	Job NewJob = {Function, UserData, Counter};
+
+	SDL_LockMutex(GJobs.Mutex);
+	bool Queued = PushJob(&NewJob);
+	SDL_UnlockMutex(GJobs.Mutex);
+
+	if (!Queued && Counter != NULL) {
+		SDL_AddAtomicInt(&Counter->Pending, -1);
+	}
+	return Queued;
+}
+
+bool JobsIsDone(JobCounter* Counter)
+{
+	return SDL_GetAtomicInt(&Counter->Pending) == 0;
+}
+
+void JobsWait(JobCounter* Counter)
+{
+	SDL_LockMutex(GJobs.Mutex);
+	while (SDL_GetAtomicInt(&Counter->Pending) > 0) {
+		Job NextJob;
+		if (PopJobFor(Counter, &NextJob)) {
+			SDL_UnlockMutex(GJobs.Mutex);
+			RunJob(&NextJob);
+			SDL_LockMutex(GJobs.Mutex);
+		} else {
+			SDL_WaitCondition(GJobs.JobFinished, GJobs.Mutex);
+		}
+	}
+	SDL_UnlockMutex(GJobs.Mutex);
+}
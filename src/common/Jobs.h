@@ -0,0 +1,27 @@
+#pragma once
+
+#include <SDL3/SDL_atomic.h>
+
+#include "Types.h"
+
+// Minimal fixed-size worker pool. Jobs are fire and forget function pointers, completion is tracked by a JobCounter
+// that any number of jobs can share. Waiting on a counter runs its own queued jobs on the waiting thread instead of
+// idling, never anyone else's.
+
+typedef void (*JobFunction)(void* UserData);
+
+typedef struct JobCounter {
+	SDL_AtomicInt Pending;
+} JobCounter;
+
+// WorkerCount <= 0 uses one worker per logical core minus the calling thread.
+void JobsInitialize(int32 WorkerCount);
+void JobsShutdown(void);
+int32 JobsGetWorkerCount(void);
+
+// Runs the job on the calling thread when the queue is full or there are no workers.
+void JobsSubmit(JobFunction Function, void* UserData, JobCounter* Counter);
+// Only ever queues for a worker, false (and Counter untouched) when the queue is full or there are no workers.
+bool JobsTrySubmit(JobFunction Function, void* UserData, JobCounter* Counter);
+bool JobsIsDone(JobCounter* Counter);
+void JobsWait(JobCounter* Counter);
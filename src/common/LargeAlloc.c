@@ -0,0 +1,241 @@
+#include "LargeAlloc.h"
+
+#include <SDL3/SDL.h>
+
+#include "Log.h"
+
+#if __LINUX__
+#include <sys/mman.h>
+#else
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+// Transparent huge pages on x86_64 and arm64 with 4 KB base pages, and the large page minimum on Windows x64.
+#define LARGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+#define LARGE_BASE_PAGE_SIZE ((size_t)4096)
+// Displays, the screenshot and a few staging buffers, nowhere near this.
+#define LARGE_ALLOC_MAX_BLOCKS 64
+
+typedef struct LargeBlock {
+	void* Pointer; // NULL when the slot is free
+	size_t Size;   // As mapped
+	MemoryTag Tag;
+} LargeBlock;
+
+static struct {
+	SDL_SpinLock Lock;
+	LargeBlock Blocks[LARGE_ALLOC_MAX_BLOCKS];
+	bool SmallPagesOnly;
+#if !__LINUX__
+	size_t LargePageMinimum; // Nonzero once SeLockMemoryPrivilege is enabled for the process
+#endif
+} GLargeAlloc;
+
+#if __LINUX__
+static void* LargeMap(size_t Size, bool HugePages)
+{
+	if (Size < LARGE_PAGE_SIZE) {
+		void* Pointer = mmap(NULL, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		return (Pointer != MAP_FAILED) ? Pointer : NULL;
+	}
+
+	// Over-map by a huge page and trim both ends so the block starts on a huge page boundary, otherwise the first and
+	// last partial huge page of the range stay small.
+	size_t Padded = Size + LARGE_PAGE_SIZE;
+	uint8* Mapping = mmap(NULL, Padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (Mapping == MAP_FAILED) {
+		return NULL;
+	}
+	uint8* Aligned = (uint8*)(((uintptr_t)Mapping + LARGE_PAGE_SIZE - 1) & ~(uintptr_t)(LARGE_PAGE_SIZE - 1));
+	if (Aligned > Mapping) {
+		munmap(Mapping, Aligned - Mapping);
+	}
+	if (Aligned + Size < Mapping + Padded) {
+		munmap(Aligned + Size, (Mapping + Padded) - (Aligned + Size));
+	}
+
+	// With THP set to always the kernel would use huge pages unasked, opting out keeps comparisons honest. Kernels
+	// without THP reject the advice, the block works the same with small pages.
+	madvise(Aligned, Size, HugePages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+	return Aligned;
+}
+
+static void LargeUnmap(void* Pointer, size_t Size)
+{
+	munmap(Pointer, Size);
+}
+#else
+static void* LargeMap(size_t Size, bool HugePages)
+{
+	if (HugePages && GLargeAlloc.LargePageMinimum != 0 && Size % GLargeAlloc.LargePageMinimum == 0) {
+		void* Pointer = VirtualAlloc(NULL, Size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+		// Large pages have to be physically contiguous, a fragmented system fails and gets small pages instead.
+		if (Pointer != NULL) {
+			return Pointer;
+		}
+	}
+	return VirtualAlloc(NULL, Size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+static void LargeUnmap(void* Pointer, size_t Size)
+{
+	VirtualFree(Pointer, 0, MEM_RELEASE);
+}
+#endif
+
+void LargeAllocInitialize(void)
+{
+#if __LINUX__
+	size_t Length = 0;
+	char* Settings = SDL_LoadFile("/sys/kernel/mm/transparent_hugepage/enabled", &Length);
+	// The active mode is the bracketed one, e.g. "always [madvise] never".
+	const char* Mode = (Settings != NULL) ? SDL_strchr(Settings, '[') : NULL;
+	const char* ModeEnd = (Mode != NULL) ? SDL_strchr(Mode, ']') : NULL;
+	if (ModeEnd != NULL) {
+		char ModeName[32];
+		SDL_strlcpy(ModeName, Mode + 1, SDL_min((size_t)(ModeEnd - Mode), sizeof(ModeName)));
+		LogInfo("LargeAlloc: Transparent huge pages set to %s", ModeName);
+	} else {
+		LogInfo("LargeAlloc: Transparent huge pages unavailable, pixel buffers use small pages");
+	}
+	SDL_free(Settings);
+#else
+	HANDLE Token;
+	if (OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &Token)) {
+		TOKEN_PRIVILEGES Privileges = {.PrivilegeCount = 1};
+		Privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+		// Adjusting succeeds even when the account doesn't hold the privilege, only the last error tells.
+		if (LookupPrivilegeValueA(NULL, "SeLockMemoryPrivilege", &Privileges.Privileges[0].Luid) &&
+			AdjustTokenPrivileges(Token, FALSE, &Privileges, 0, NULL, NULL) && GetLastError() == ERROR_SUCCESS)
+		{
+			GLargeAlloc.LargePageMinimum = GetLargePageMinimum();
+		}
+		CloseHandle(Token);
+	}
+	if (GLargeAlloc.LargePageMinimum != 0) {
+		LogInfo("LargeAlloc: Large pages of %d KB enabled", (int)(GLargeAlloc.LargePageMinimum / 1024));
+	} else {
+		LogInfo("LargeAlloc: No SeLockMemoryPrivilege, pixel buffers use small pages");
+	}
+#endif
+}
+
+void LargeAllocEnableHugePages(bool Enable)
+{
+	GLargeAlloc.SmallPagesOnly = !Enable;
+}
+
+size_t LargeAllocGetMappedSize(size_t Size)
+{
+	size_t Granularity = (Size < LARGE_PAGE_SIZE) ? LARGE_BASE_PAGE_SIZE : LARGE_PAGE_SIZE;
+	return (Size + Granularity - 1) & ~(Granularity - 1);
+}
+
+void* LargeAlloc(MemoryTag DefaultTag, size_t Size)
+{
+	if (Size == 0 || Size > SIZE_MAX - LARGE_PAGE_SIZE * 2) {
+		return NULL;
+	}
+
+	size_t MappedSize = LargeAllocGetMappedSize(Size);
+	void* Pointer = LargeMap(MappedSize, !GLargeAlloc.SmallPagesOnly);
+	if (Pointer == NULL) {
+		LogError("LargeAlloc: Unable to map %d KB", (int)(MappedSize / 1024));
+		return NULL;
+	}
+
+	MemoryTag Tag = MemoryResolveTag(DefaultTag);
+	SDL_LockSpinlock(&GLargeAlloc.Lock);
+	LargeBlock* Block = NULL;
+	for (int32 Index = 0; Block == NULL && Index < LARGE_ALLOC_MAX_BLOCKS; Index++) {
+		if (GLargeAlloc.Blocks[Index].Pointer == NULL) {
+			Block = &GLargeAlloc.Blocks[Index];
+			*Block = (LargeBlock){Pointer, MappedSize, Tag};
+		}
+	}
+	SDL_UnlockSpinlock(&GLargeAlloc.Lock);
+
+	if (Block == NULL) {
+		LogError("LargeAlloc: All %d blocks are in use", LARGE_ALLOC_MAX_BLOCKS);
+		LargeUnmap(Pointer, MappedSize);
+		return NULL;
+	}
+
+	MemoryTrackMapped(Tag, (int64)MappedSize);
+	return Pointer;
+}
+
+void LargeFree(void* Pointer)
+{
+	if (Pointer == NULL) {
+		return;
+	}
+
+	LargeBlock Freed = {0};
+	SDL_LockSpinlock(&GLargeAlloc.Lock);
+	for (int32 Index = 0; Index < LARGE_ALLOC_MAX_BLOCKS; Index++) {
+		if (GLargeAlloc.Blocks[Index].Pointer == Pointer) {
+			Freed = GLargeAlloc.Blocks[Index];
+			GLargeAlloc.Blocks[Index] = (LargeBlock){0};
+			break;
+		}
+	}
+	SDL_UnlockSpinlock(&GLargeAlloc.Lock);
+
+	ASSERT(Freed.Pointer != NULL && "Block wasn't allocated with LargeAlloc.");
+	if (Freed.Pointer != NULL) {
+		LargeUnmap(Freed.Pointer, Freed.Size);
+		MemoryTrackMapped(Freed.Tag, -(int64)Freed.Size);
+	}
+}
+
+uint8* LargeBufferReserve(LargeBuffer* Buffer, MemoryTag Tag, size_t Size)
+{
+	if (Size > Buffer->Capacity) {
+		LargeBufferRelease(Buffer);
+		Buffer->Memory = LargeAlloc(Tag, Size);
+		Buffer->Capacity = (Buffer->Memory != NULL) ? LargeAllocGetMappedSize(Size) : 0;
+	}
+	return Buffer->Memory;
+}
+
+void LargeBufferRelease(LargeBuffer* Buffer)
+{
+	LargeFree(Buffer->Memory);
+	*Buffer = (LargeBuffer){0};
+}
+
+static void LargeSurfaceDestroy(void* UserData, void* Value)
+{
+	LargeFree(Value);
+}
+
+SDL_Surface* CreateLargeSurface(int32 Width, int32 Height, SDL_PixelFormat Format, MemoryTag Tag)
+{
+	ASSERT(!SDL_ISPIXELFORMAT_FOURCC(Format) && SDL_BYTESPERPIXEL(Format) > 0);
+	int32 Pitch = Width * SDL_BYTESPERPIXEL(Format);
+	void* Pixels = LargeAlloc(Tag, (size_t)Pitch * Height);
+	if (Pixels == NULL) {
+		return NULL;
+	}
+
+	SDL_Surface* Surface = SDL_CreateSurfaceFrom(Width, Height, Format, Pixels, Pitch);
+	if (Surface == NULL) {
+		LargeFree(Pixels);
+		return NULL;
+	}
+
+	// SDL runs the cleanup itself when setting the property fails, the pixels are gone either way then.
+	if (!SDL_SetPointerPropertyWithCleanup(
+			SDL_GetSurfaceProperties(Surface),
+			"shaver.large_alloc.pixels",
+			Pixels,
+			LargeSurfaceDestroy,
+			NULL))
+	{
+		SDL_DestroySurface(Surface);
+		return NULL;
+	}
+	return Surface;
+}
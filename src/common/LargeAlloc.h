@@ -0,0 +1,37 @@
+#pragma once
+
+#include <SDL3/SDL_surface.h>
+
+#include "MemoryTracker.h"
+#include "Types.h"
+
+// Page mapped blocks for full screen pixel buffers, which are tens of MB and stream through on every shave frame.
+// Blocks of 2 MB or more are 2 MB aligned and sized, and on Linux are madvise'd MADV_HUGEPAGE so transparent huge pages
+// back them, one TLB entry then covers 512 small pages. Windows uses MEM_LARGE_PAGES when the account holds
+// SeLockMemoryPrivilege and regular pages otherwise. Memory comes back zeroed and shows up under its tag in the
+// memory tracker like heap blocks do.
+
+// Probes what the system offers and logs it. Optional, blocks are still handed out without it, with regular pages on
+// Windows.
+void LargeAllocInitialize(void);
+// On by default. Off maps blocks the same way but asks for small pages, for comparing the two.
+void LargeAllocEnableHugePages(bool Enable);
+
+// Takes the calling thread's memory tag if one is pushed, like MemoryAlloc. NULL when mapping fails.
+void* LargeAlloc(MemoryTag DefaultTag, size_t Size);
+void LargeFree(void* Pointer);
+// Bytes actually mapped for a block of Size, what a LargeBuffer can grow into without remapping.
+size_t LargeAllocGetMappedSize(size_t Size);
+
+// A scratch buffer that only ever grows, its contents don't survive growing.
+typedef struct LargeBuffer {
+	uint8* Memory;
+	size_t Capacity;
+} LargeBuffer;
+
+// Returns Buffer->Memory with room for at least Size bytes, NULL when mapping fails.
+uint8* LargeBufferReserve(LargeBuffer* Buffer, MemoryTag Tag, size_t Size);
+void LargeBufferRelease(LargeBuffer* Buffer);
+
+// A surface over a large block, tightly pitched. The block is unmapped by SDL_DestroySurface.
+SDL_Surface* CreateLargeSurface(int32 Width, int32 Height, SDL_PixelFormat Format, MemoryTag Tag);
@@ -1,6 +1,20 @@
 #include "Log.h"
 
+// The functions stay available in binary builds, they format eagerly into text records.
+#ifdef LOGGING_BINARY
+#undef LogVerbose
+#undef LogInfo
+#undef LogWarning
+#undef LogError
+// log.bin replaces log.txt.
+#undef LOGGING_WRITE_TO_FILE
+#endif
+
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_mutex.h>
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_thread.h>
+#include <SDL3/SDL_timer.h>
 #include <stdarg.h>
 #include <stdio.h>
 
@@ -17,7 +31,7 @@ enum TermColor {
 	TermColor_Count,
 };
 
-const char* LogLevelNames[] = {
+const char* LogLevelNames[LogLevel_Count] = {
 	"NONE",
 	"Error",
 	"Warning",
@@ -42,9 +56,45 @@ LogLevel GLogLevel = LogLevel_Disabled;
 #ifdef LOGGING_WRITE_TO_FILE
 FILE* GLogFile;
 #endif
+#ifdef LOGGING_BINARY
+FILE* GLogBinaryFile;
+#endif
+
+// Producers encode on the calling thread and publish into a bounded MPSC ring (Vyukov-style per-slot sequence
+// numbers), the writer thread drains it and batches each run of same-level records into a single write. Records
+// hold formatted text, or in binary builds the encoded log.bin record.
+#define LOG_RING_SIZE 512
+#define LOG_RECORD_SIZE 1024
+#define LOG_BATCH_SIZE (64 * 1024)
+#define LOG_MAX_ARGS 32
+_Static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "Ring size must be a power of two");
+
+typedef struct LogRecord {
+	SDL_AtomicU32 Sequence;
+	LogLevel Level;
+	int32 Length;
+	char Text[LOG_RECORD_SIZE];
+} LogRecord;
+
+static struct {
+	LogRecord Ring[LOG_RING_SIZE];
+	SDL_AtomicU32 EnqueuePos;
+	SDL_AtomicU32 WrittenPos;
+	uint32 DequeuePos; // Owned by the writer thread.
+	SDL_AtomicInt Dropped;
+	SDL_AtomicInt Sleeping;
+	SDL_AtomicInt Quit;
+	SDL_AtomicInt NextCallsiteId; // Never reset, call sites keep their ids for the life of the process.
+	SDL_Semaphore* Wake;
+	SDL_Thread* Writer;
+	char Batch[LOG_BATCH_SIZE];
+} GLog;
 
 static void _InternalLogV(LogLevel Level, const char* Format, va_list Args);
+static void _InternalLogText(LogLevel Level, const char* Message);
 static void _InternalSetTerminalColor(enum TermColor Color);
+static void _InternalWrite(enum TermColor Color, const char* Text, size_t Length);
+static int _InternalWriterThread(void* Data);
 
 void LoggingInitialize(LogLevel Level)
 {
@@ -52,6 +102,29 @@ void LoggingInitialize(LogLevel Level)
 #ifdef LOGGING_WRITE_TO_FILE
 	GLogFile = fopen("log.txt", "w");
 #endif
+#ifdef LOGGING_BINARY
+	GLogBinaryFile = fopen("log.bin", "wb");
+	if (GLogBinaryFile) {
+		LogBinaryHeader Header = {.Magic = LOG_BINARY_MAGIC, .Version = LOG_BINARY_VERSION};
+		fwrite(&Header, sizeof(Header), 1, GLogBinaryFile);
+	}
+#endif
+
+	for (uint32 Index = 0; Index < LOG_RING_SIZE; ++Index) {
+		SDL_SetAtomicU32(&GLog.Ring[Index].Sequence, Index);
+	}
+	SDL_SetAtomicU32(&GLog.EnqueuePos, 0);
+	SDL_SetAtomicU32(&GLog.WrittenPos, 0);
+	GLog.DequeuePos = 0;
+	SDL_SetAtomicInt(&GLog.Dropped, 0);
+	SDL_SetAtomicInt(&GLog.Sleeping, 0);
+	SDL_SetAtomicInt(&GLog.Quit, 0);
+
+	// Without a writer every call falls back to writing synchronously.
+	GLog.Wake = SDL_CreateSemaphore(0);
+	if (GLog.Wake) {
+		GLog.Writer = SDL_CreateThread(_InternalWriterThread, "LogWriter", NULL);
+	}
 
 	LogInfo(__FUNCTION__);
 }
@@ -60,10 +133,46 @@ void LoggingShutdown(void)
 {
 	LogInfo(__FUNCTION__);
 	GLogLevel = LogLevel_None;
+
+	if (GLog.Writer) {
+		// The writer drains everything published before it sees the quit flag.
+		SDL_SetAtomicInt(&GLog.Quit, 1);
+		SDL_SignalSemaphore(GLog.Wake);
+		SDL_WaitThread(GLog.Writer, NULL);
+		GLog.Writer = NULL;
+	}
+	if (GLog.Wake) {
+		SDL_DestroySemaphore(GLog.Wake);
+		GLog.Wake = NULL;
+	}
+
 #ifdef LOGGING_WRITE_TO_FILE
 	fclose(GLogFile);
+#endif
+#ifdef LOGGING_BINARY
+	if (GLogBinaryFile) {
+		fclose(GLogBinaryFile);
+		GLogBinaryFile = NULL;
+	}
 #endif
 	_InternalSetTerminalColor(TermColor_Normal);
+	fflush(stdout);
+}
+
+void LoggingFlush(void)
+{
+	if (!GLog.Writer) {
+		fflush(stdout);
+		return;
+	}
+
+	// Bounded so a producer that died between claiming and publishing a slot can't hang a panic.
+	uint32 Target = SDL_GetAtomicU32(&GLog.EnqueuePos);
+	uint64 Deadline = SDL_GetTicks() + 1000;
+	while ((int32)(SDL_GetAtomicU32(&GLog.WrittenPos) - Target) < 0 && SDL_GetTicks() < Deadline) {
+		SDL_SignalSemaphore(GLog.Wake);
+		SDL_Delay(1);
+	}
 }
 
 void LoggingSetLogLevel(LogLevel Level)
@@ -101,7 +210,7 @@ void LogWarning(const char* Format, ...)
 	}
 }
 
-void LogError(const void* Format, ...)
+void LogError(const char* Format, ...)
 {
 	if (GLogLevel >= LogLevel_Error) {
 		va_list Args;
@@ -111,19 +220,394 @@ void LogError(const void* Format, ...)
 	}
 }
 
+static int64 _InternalArgAsInt(LogArg Arg)
+{
+	switch (Arg.Type) {
+		case LogArgType_Int: return Arg.Int;
+		case LogArgType_UInt: return (int64)Arg.UInt;
+		case LogArgType_Float: return (int64)Arg.Float;
+		case LogArgType_Pointer: return (int64)(intptr_t)Arg.Pointer;
+		default: return 0;
+	}
+}
+
+static float64 _InternalArgAsFloat(LogArg Arg)
+{
+	switch (Arg.Type) {
+		case LogArgType_Int: return (float64)Arg.Int;
+		case LogArgType_UInt: return (float64)Arg.UInt;
+		case LogArgType_Float: return Arg.Float;
+		default: return 0.0;
+	}
+}
+
+// Produces what SDL_snprintf would have for the original call. Flags, width and precision are kept, the length
+// modifier is replaced to match how the argument was captured, ints are narrowed back unless it asked for l or ll.
+int32 LogFormatArgs(char* Buffer, int32 Size, const char* Format, const LogArg* Args, int32 ArgCount)
+{
+	int32 ArgIndex = 0;
+	int32 Length = 0;
+
+	const char* Cursor = Format;
+	while (*Cursor != '\0' && Length < Size - 1) {
+		if (Cursor[0] != '%' || Cursor[1] == '%') {
+			Buffer[Length++] = *Cursor;
+			Cursor += (Cursor[0] == '%') ? 2 : 1;
+			continue;
+		}
+
+		char Spec[32];
+		int32 SpecLength = 0;
+		Spec[SpecLength++] = *Cursor++;
+		while (*Cursor != '\0' && SDL_strchr("-+ #0123456789.", *Cursor) != NULL && SpecLength < 24) {
+			Spec[SpecLength++] = *Cursor++;
+		}
+		bool Wide = false;
+		while (*Cursor != '\0' && SDL_strchr("hlLjzt", *Cursor) != NULL) {
+			Wide |= *Cursor != 'h';
+			Cursor++;
+		}
+		char Conversion = *Cursor;
+		if (Conversion == '\0') {
+			break;
+		}
+		Cursor++;
+
+		LogArg Arg = (ArgIndex < ArgCount) ? Args[ArgIndex++] : (LogArg){0};
+		int32 Remaining = Size - Length;
+		int Written = 0;
+		switch (Conversion) {
+			case 'd':
+			case 'i': {
+				int64 Value = Wide ? _InternalArgAsInt(Arg) : (int)_InternalArgAsInt(Arg);
+				SDL_memcpy(Spec + SpecLength, "lld", 4);
+				Written = SDL_snprintf(Buffer + Length, Remaining, Spec, (long long)Value);
+			} break;
+			case 'u':
+			case 'o':
+			case 'x':
+			case 'X': {
+				uint64 Value = Wide ? (uint64)_InternalArgAsInt(Arg) : (unsigned int)_InternalArgAsInt(Arg);
+				SDL_memcpy(Spec + SpecLength, (char[]){'l', 'l', Conversion, '\0'}, 4);
+				Written = SDL_snprintf(Buffer + Length, Remaining, Spec, (unsigned long long)Value);
+			} break;
+			case 'c':
+				SDL_memcpy(Spec + SpecLength, "c", 2);
+				Written = SDL_snprintf(Buffer + Length, Remaining, Spec, (int)_InternalArgAsInt(Arg));
+				break;
+			case 'f':
+			case 'F':
+			case 'e':
+			case 'E':
+			case 'g':
+			case 'G':
+			case 'a':
+			case 'A':
+				SDL_memcpy(Spec + SpecLength, (char[]){Conversion, '\0'}, 2);
+				Written = SDL_snprintf(Buffer + Length, Remaining, Spec, _InternalArgAsFloat(Arg));
+				break;
+			case 's':
+				SDL_memcpy(Spec + SpecLength, "s", 2);
+				Written = SDL_snprintf(
+					Buffer + Length,
+					Remaining,
+					Spec,
+					(Arg.Type == LogArgType_String && Arg.String) ? Arg.String : "(?)");
+				break;
+			case 'p':
+				SDL_memcpy(Spec + SpecLength, "p", 2);
+				Written = SDL_snprintf(Buffer + Length, Remaining, Spec, Arg.Pointer);
+				break;
+			default: Written = SDL_snprintf(Buffer + Length, Remaining, "%%%c", Conversion); break;
+		}
+		Length += SDL_clamp(Written, 0, Remaining - 1);
+	}
+
+	Buffer[Length] = '\0';
+	return Length;
+}
+
+// Returns the slot to encode into, the caller's own record when there is no writer to hand it to, or NULL when the
+// ring is full. Never blocks the caller on the writer.
+static LogRecord* _InternalBeginRecord(LogRecord* Local, uint32* Pos)
+{
+	if (!GLog.Writer) {
+		return Local;
+	}
+
+	*Pos = SDL_GetAtomicU32(&GLog.EnqueuePos);
+	for (;;) {
+		LogRecord* Record = &GLog.Ring[*Pos & (LOG_RING_SIZE - 1)];
+		int32 Diff = (int32)(SDL_GetAtomicU32(&Record->Sequence) - *Pos);
+		if (Diff == 0) {
+			if (SDL_CompareAndSwapAtomicU32(&GLog.EnqueuePos, *Pos, *Pos + 1)) {
+				return Record;
+			}
+			*Pos = SDL_GetAtomicU32(&GLog.EnqueuePos);
+		} else if (Diff < 0) {
+			SDL_AddAtomicInt(&GLog.Dropped, 1);
+			return NULL;
+		} else {
+			*Pos = SDL_GetAtomicU32(&GLog.EnqueuePos);
+		}
+	}
+}
+
+static void _InternalEndRecord(LogRecord* Record, LogRecord* Local, uint32 Pos)
+{
+	if (Record == Local) {
+		_InternalWrite(LogLevelColors[Record->Level], Record->Text, Record->Length);
+		return;
+	}
+
+	SDL_SetAtomicU32(&Record->Sequence, Pos + 1);
+
+	// Only pay for the semaphore when the writer is actually parked.
+	if (SDL_SetAtomicInt(&GLog.Sleeping, 0)) {
+		SDL_SignalSemaphore(GLog.Wake);
+	}
+}
+
+#ifdef LOGGING_BINARY
+typedef struct LogEncoder {
+	char* Data;
+	int32 Length;
+} LogEncoder;
+
+static void _InternalPut(LogEncoder* Encoder, const void* Data, int32 Size)
+{
+	ASSERT(Encoder->Length + Size <= LOG_RECORD_SIZE);
+	SDL_memcpy(Encoder->Data + Encoder->Length, Data, Size);
+	Encoder->Length += Size;
+}
+
+// clang-format off
+#define DEFINE_LOG_PUT(T, Name) \
+	static void CAT(_InternalPut, Name)(LogEncoder* Encoder, T Value) \
+	{ \
+		_InternalPut(Encoder, &Value, sizeof(Value)); \
+	}
+DEFINE_LOG_PUT(uint8, U8)
+DEFINE_LOG_PUT(uint16, U16)
+DEFINE_LOG_PUT(uint32, U32)
+DEFINE_LOG_PUT(uint64, U64)
+#undef DEFINE_LOG_PUT
+// clang-format on
+
+// Truncated so Reserve bytes are still free afterwards.
+static void _InternalPutString(LogEncoder* Encoder, const char* String, int32 Reserve)
+{
+	String = String ? String : "(null)";
+	int32 Available = LOG_RECORD_SIZE - Encoder->Length - Reserve - (int32)sizeof(uint16);
+	uint16 Length = (uint16)SDL_min((int32)SDL_strlen(String), SDL_max(Available, 0));
+	_InternalPutU16(Encoder, Length);
+	_InternalPut(Encoder, String, Length);
+}
+
+static int32 _InternalEncodeText(char* Data, LogLevel Level, const char* Message)
+{
+	LogEncoder Encoder = {Data, 0};
+	_InternalPutU8(&Encoder, LogRecordKind_Text);
+	_InternalPutU8(&Encoder, Level);
+	_InternalPutU64(&Encoder, SDL_GetTicksNS());
+	_InternalPutString(&Encoder, Message, 0);
+	return Encoder.Length;
+}
+
+// Publishes the call site record ahead of any message using its id, so the decoder can read the file in one pass.
+// Returns the id, or 0 while it isn't registered yet.
+static int32 _InternalRegisterCallsite(LogCallsite* Site, const char* Format)
+{
+	// -1 marks a registration in flight, callers format eagerly until it lands.
+	if (!SDL_CompareAndSwapAtomicInt(&Site->Id, 0, -1)) {
+		return SDL_max(SDL_GetAtomicInt(&Site->Id), 0);
+	}
+
+	LogRecord Local;
+	uint32 Pos = 0;
+	LogRecord* Record = _InternalBeginRecord(&Local, &Pos);
+	if (!Record) {
+		SDL_SetAtomicInt(&Site->Id, 0);
+		return 0;
+	}
+
+	int32 Id = SDL_AddAtomicInt(&GLog.NextCallsiteId, 1) + 1;
+	LogEncoder Encoder = {Record->Text, 0};
+	_InternalPutU8(&Encoder, LogRecordKind_Callsite);
+	_InternalPutU32(&Encoder, Id);
+	_InternalPutU8(&Encoder, Site->Level);
+	_InternalPutU32(&Encoder, Site->Line);
+	_InternalPutString(&Encoder, Site->File, LOG_RECORD_SIZE / 2);
+	_InternalPutString(&Encoder, Format, 0);
+	Record->Level = Site->Level;
+	Record->Length = Encoder.Length;
+	_InternalEndRecord(Record, &Local, Pos);
+
+	Site->Format = Format;
+	SDL_SetAtomicInt(&Site->Id, Id);
+	return Id;
+}
+#endif
+
+void LogCallsiteArgs(LogCallsite* Site, const char* Format, const LogArg* Args, int32 ArgCount)
+{
+	if (GLogLevel < Site->Level) {
+		return;
+	}
+
+#ifdef LOGGING_BINARY
+	int32 Id = SDL_GetAtomicInt(&Site->Id);
+	if (Id <= 0) {
+		Id = _InternalRegisterCallsite(Site, Format);
+	}
+	if (Id > 0 && Format == Site->Format) {
+		LogRecord Local;
+		uint32 Pos = 0;
+		LogRecord* Record = _InternalBeginRecord(&Local, &Pos);
+		if (!Record) {
+			return;
+		}
+
+		ArgCount = SDL_min(ArgCount, LOG_MAX_ARGS);
+		LogEncoder Encoder = {Record->Text, 0};
+		_InternalPutU8(&Encoder, LogRecordKind_Message);
+		_InternalPutU32(&Encoder, Id);
+		_InternalPutU64(&Encoder, SDL_GetTicksNS());
+		_InternalPutU8(&Encoder, ArgCount);
+		for (int32 Index = 0; Index < ArgCount; Index++) {
+			_InternalPutU8(&Encoder, Args[Index].Type);
+			if (Args[Index].Type == LogArgType_String) {
+				// Leave room for every argument after this one at its largest fixed size.
+				int32 Reserve = (ArgCount - Index - 1) * (1 + (int32)sizeof(uint64));
+				_InternalPutString(&Encoder, Args[Index].String, Reserve);
+			} else {
+				_InternalPutU64(&Encoder, Args[Index].UInt);
+			}
+		}
+		Record->Level = Site->Level;
+		Record->Length = Encoder.Length;
+		_InternalEndRecord(Record, &Local, Pos);
+		return;
+	}
+#endif
+
+	char Message[LOG_RECORD_SIZE];
+	LogFormatArgs(Message, sizeof(Message), Format, Args, ArgCount);
+	_InternalLogText(Site->Level, Message);
+}
+
 static void _InternalLogV(LogLevel Level, const char* Format, va_list Args)
 {
-	_InternalSetTerminalColor(LogLevelColors[Level]);
+	char Message[LOG_RECORD_SIZE];
+	SDL_vsnprintf(Message, sizeof(Message), Format, Args);
+	_InternalLogText(Level, Message);
+}
+
+static int32 _InternalFormatText(char* Text, LogLevel Level, const char* Message)
+{
+#ifdef LOGGING_BINARY
+	return _InternalEncodeText(Text, Level, Message);
+#else
+	int32 Length = SDL_snprintf(Text, LOG_RECORD_SIZE, "[%s] %s", LogLevelNames[Level], Message);
+	// Truncated messages keep their newline.
+	Length = SDL_clamp(Length, 0, LOG_RECORD_SIZE - 2);
+	Text[Length++] = '\n';
+	Text[Length] = '\0';
+	return Length;
+#endif
+}
+
+static void _InternalLogText(LogLevel Level, const char* Message)
+{
+	LogRecord Local;
+	uint32 Pos = 0;
+	LogRecord* Record = _InternalBeginRecord(&Local, &Pos);
+	if (Record) {
+		Record->Level = Level;
+		Record->Length = _InternalFormatText(Record->Text, Level, Message);
+		_InternalEndRecord(Record, &Local, Pos);
+	}
+}
 
-	FixedArray(char, 1024) Formatted;
-	SDL_vsnprintf(Formatted.Data, FixedArrayCapacity(Formatted), Format, Args);
+static bool _InternalRingIsEmpty(void)
+{
+	LogRecord* Record = &GLog.Ring[GLog.DequeuePos & (LOG_RING_SIZE - 1)];
+	return SDL_GetAtomicU32(&Record->Sequence) != GLog.DequeuePos + 1;
+}
 
-	FixedArray(char, 1024) Output;
-	SDL_snprintf(Output.Data, FixedArrayCapacity(Output), "[%s] %s\n", LogLevelNames[Level], Formatted.Data);
+static void _InternalDrain(void)
+{
+	enum TermColor BatchColor = TermColor_Normal;
+	size_t BatchLength = 0;
+
+	int Dropped = SDL_SetAtomicInt(&GLog.Dropped, 0);
+	if (Dropped > 0) {
+		char Message[64];
+		SDL_snprintf(Message, sizeof(Message), "Log: dropped %d messages, ring full", Dropped);
+		BatchColor = LogLevelColors[LogLevel_Warning];
+		BatchLength = _InternalFormatText(GLog.Batch, LogLevel_Warning, Message);
+	}
+
+	while (!_InternalRingIsEmpty()) {
+		LogRecord* Record = &GLog.Ring[GLog.DequeuePos & (LOG_RING_SIZE - 1)];
+		enum TermColor Color = LogLevelColors[Record->Level];
+		if (BatchLength > 0 && (Color != BatchColor || BatchLength + Record->Length > LOG_BATCH_SIZE)) {
+			_InternalWrite(BatchColor, GLog.Batch, BatchLength);
+			BatchLength = 0;
+		}
+		BatchColor = Color;
+		SDL_memcpy(GLog.Batch + BatchLength, Record->Text, Record->Length);
+		BatchLength += Record->Length;
 
-	fprintf(stdout, Output.Data);
+		SDL_SetAtomicU32(&Record->Sequence, GLog.DequeuePos + LOG_RING_SIZE);
+		GLog.DequeuePos++;
+	}
+
+	if (BatchLength > 0) {
+		_InternalWrite(BatchColor, GLog.Batch, BatchLength);
+		fflush(stdout);
 #ifdef LOGGING_WRITE_TO_FILE
-	fprintf(GLogFile, Output.Data);
+		fflush(GLogFile);
+#endif
+#ifdef LOGGING_BINARY
+		if (GLogBinaryFile) {
+			fflush(GLogBinaryFile);
+		}
+#endif
+	}
+	SDL_SetAtomicU32(&GLog.WrittenPos, GLog.DequeuePos);
+}
+
+static int _InternalWriterThread(void* Data)
+{
+	(void)Data;
+	while (!SDL_GetAtomicInt(&GLog.Quit)) {
+		_InternalDrain();
+
+		// Re-check after announcing so a record published in between can't be missed.
+		SDL_SetAtomicInt(&GLog.Sleeping, 1);
+		if (_InternalRingIsEmpty() && !SDL_GetAtomicInt(&GLog.Quit)) {
+			SDL_WaitSemaphoreTimeout(GLog.Wake, 100);
+		}
+		SDL_SetAtomicInt(&GLog.Sleeping, 0);
+	}
+	_InternalDrain();
+	return 0;
+}
+
+static void _InternalWrite(enum TermColor Color, const char* Text, size_t Length)
+{
+#ifdef LOGGING_BINARY
+	(void)Color;
+	if (GLogBinaryFile) {
+		fwrite(Text, 1, Length, GLogBinaryFile);
+	}
+#else
+	_InternalSetTerminalColor(Color);
+	fwrite(Text, 1, Length, stdout);
+#ifdef LOGGING_WRITE_TO_FILE
+	fwrite(Text, 1, Length, GLogFile);
+#endif
 #endif
 }
 
@@ -175,8 +659,10 @@ static void _InternalSetTerminalColor(enum TermColor Color)
 	// TODO: better cross-platform implementation (separate translation units per platform)
 #if __LINUX__
 	ASSERT(VALID_INDEX(Color, TermColor_Count));
-	printf("%s", TermColorCodes[Color]);
+	fputs(TermColorCodes[Color], stdout);
 #elif __WINDOWS__
+	// Buffered text has to reach the console before its attribute changes.
+	fflush(stdout);
 	HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
 	SetConsoleTextAttribute(hConsole, TermColorCodes[Color]);
 #else
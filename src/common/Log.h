@@ -1,5 +1,7 @@
 #pragma once
 
+#include <SDL3/SDL_atomic.h>
+
 #include "Types.h"
 
 typedef enum LogLevel {
@@ -14,9 +16,116 @@ typedef enum LogLevel {
 
 void LoggingInitialize(LogLevel Level);
 void LoggingShutdown(void);
+// Blocks until every message logged so far has been written, used before aborting.
+void LoggingFlush(void);
 void LoggingSetLogLevel(LogLevel Level);
 
 void LogVerbose(const char* Format, ...);
 void LogInfo(const char* Format, ...);
 void LogWarning(const char* Format, ...);
-void LogError(const void* Format, ...);
\ No newline at end of file
+void LogError(const char* Format, ...);
+
+// printf arguments captured by value to be formatted later by LogFormatArgs, for binary logging, tools/logdecode and
+// DebugPrintf.
+typedef enum LogArgType {
+	LogArgType_Int,
+	LogArgType_UInt,
+	LogArgType_Float,
+	LogArgType_String,
+	LogArgType_Pointer,
+} LogArgType;
+
+typedef struct LogArg {
+	LogArgType Type;
+	union {
+		int64 Int;
+		uint64 UInt;
+		float64 Float;
+		const char* String;
+		const void* Pointer;
+	};
+} LogArg;
+
+// clang-format off
+#define DEFINE_LOG_ARG(T, Field) \
+	static inline LogArg CAT(LogArg, Field)(T Value) \
+	{ \
+		return (LogArg){.Type = CAT(LogArgType_, Field), .Field = Value}; \
+	}
+DEFINE_LOG_ARG(int64, Int)
+DEFINE_LOG_ARG(uint64, UInt)
+DEFINE_LOG_ARG(float64, Float)
+DEFINE_LOG_ARG(const char*, String)
+DEFINE_LOG_ARG(const void*, Pointer)
+#undef DEFINE_LOG_ARG
+
+static inline LogArg LogArgLongDouble(long double Value)
+{
+	return LogArgFloat((float64)Value);
+}
+
+// Supported argument types: every integer type is Int or UInt (bool, char and enums included), float, double and long
+// double are Float (long double narrowed to double, %Lf still formats it), char* and const char* are String and any
+// other pointer is Pointer. Anything else, e.g. a struct passed by value, doesn't compile.
+#define LOG_ARG(Value) _Generic((Value), \
+	bool: LogArgInt, char: LogArgInt, signed char: LogArgInt, short: LogArgInt, int: LogArgInt, \
+	long: LogArgInt, long long: LogArgInt, \
+	unsigned char: LogArgUInt, unsigned short: LogArgUInt, unsigned int: LogArgUInt, \
+	unsigned long: LogArgUInt, unsigned long long: LogArgUInt, \
+	float: LogArgFloat, double: LogArgFloat, long double: LogArgLongDouble, \
+	char*: LogArgString, const char*: LogArgString, \
+	default: LogArgPointer)(Value)
+#define LOG_ARG_ITEM(Value) LOG_ARG(Value),
+// The leading dummy keeps the array non-empty when there are no arguments.
+#define LOG_ARG_LIST(...) ((const LogArg[]){{0}, FOR_EACH(LOG_ARG_ITEM, __VA_ARGS__)})
+// clang-format on
+
+// Binary logging: build with LOGGING_BINARY and the Log functions become macros that register their call site (level,
+// file, line and format) once, after which each call only records the call site id, a timestamp and its raw
+// arguments into log.bin, strings copied. Nothing is formatted at runtime and nothing reaches the terminal, decode
+// the file with tools/logdecode. Formats that aren't the same pointer on every call at a site are formatted eagerly.
+typedef struct LogCallsite {
+	SDL_AtomicInt Id; // 0 until registered.
+	const char* Format;
+	const char* File;
+	int32 Line;
+	LogLevel Level;
+} LogCallsite;
+
+void LogCallsiteArgs(LogCallsite* Site, const char* Format, const LogArg* Args, int32 ArgCount);
+
+// printf subset shared with the decoder: flags, width and precision, no * or %n. Returns the length written.
+int32 LogFormatArgs(char* Buffer, int32 Size, const char* Format, const LogArg* Args, int32 ArgCount);
+
+#ifdef LOGGING_BINARY
+#define LOG_CALLSITE(SiteLevel, Format, ...)                                                                           \
+	do {                                                                                                               \
+		static LogCallsite Site = {.File = __FILE__, .Line = __LINE__, .Level = SiteLevel};                            \
+		LogCallsiteArgs(&Site, Format, LOG_ARG_LIST(__VA_ARGS__) + 1, ARRAY_COUNT(LOG_ARG_LIST(__VA_ARGS__)) - 1);     \
+	} while (0)
+#define LogVerbose(Format, ...) LOG_CALLSITE(LogLevel_Verbose, Format, __VA_ARGS__)
+#define LogInfo(Format, ...) LOG_CALLSITE(LogLevel_Info, Format, __VA_ARGS__)
+#define LogWarning(Format, ...) LOG_CALLSITE(LogLevel_Warning, Format, __VA_ARGS__)
+#define LogError(Format, ...) LOG_CALLSITE(LogLevel_Error, Format, __VA_ARGS__)
+#endif
+
+// log.bin layout, native endian: LogBinaryHeader followed by packed records, each starting with a LogRecordKind byte.
+//   Callsite: u32 id, u8 level, u32 line, u16 + file bytes, u16 + format bytes
+//   Message:  u32 id, u64 timestamp ns, u8 arg count, per argument u8 LogArgType then 8 bytes or u16 + string bytes
+//   Text:     u8 level, u64 timestamp ns, u16 + text bytes
+#define LOG_BINARY_MAGIC "SSLOGBIN"
+#define LOG_BINARY_VERSION 1
+
+typedef struct LogBinaryHeader {
+	char Magic[8];
+	uint32 Version;
+	uint32 Reserved;
+} LogBinaryHeader;
+
+typedef enum LogRecordKind {
+	LogRecordKind_Callsite = 1,
+	LogRecordKind_Message,
+	LogRecordKind_Text,
+} LogRecordKind;
+
+extern const char* LogLevelNames[LogLevel_Count];
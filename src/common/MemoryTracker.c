@@ -0,0 +1,383 @@
+#include "MemoryTracker.h"
+
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include "Log.h"
+
+static const char* MemoryTagNames[] = {
+	"untagged",
+	"screenshot",
+	"shaved",
+	"patterns",
+	"stb_ds",
+	"stb_image",
+	"strpool",
+	"frame_arena",
+};
+_Static_assert(ARRAY_COUNT(MemoryTagNames) == MemoryTag_Count, "");
+
+#if MEMORY_TRACKING
+#define MEMORY_HEADER_MAGIC 0x4D454D54
+
+typedef struct MemoryHeader {
+	size_t Size;
+	uint32 Tag;
+	uint32 Magic;
+} MemoryHeader;
+_Static_assert(sizeof(MemoryHeader) == 16, "Header has to keep the allocator's 16 byte alignment");
+
+typedef struct MemoryTagCounters {
+	SDL_SpinLock Lock;
+	MemoryTagStats Stats;
+	uint64 WindowCount; // TotalCount and TotalBytes at the start of the current rate window
+	uint64 WindowBytes;
+} MemoryTagCounters;
+
+static struct {
+	SDL_malloc_func Malloc;
+	SDL_calloc_func Calloc;
+	SDL_realloc_func Realloc;
+	SDL_free_func Free;
+	MemoryTagCounters Tags[MemoryTag_Count];
+	uint64 WindowStartNS;
+	bool SteadyState;
+	uint64 SteadyFrames;
+	uint64 AllocatingFrames;
+	uint64 SuppressedFrames; // Allocating frames not logged since the last report
+	uint64 LastReportNS;
+} GMemory;
+
+static _Thread_local MemoryTag TMemoryTag = MemoryTag_Untagged;
+// Allocations made by this thread, reallocs included. Only the thread itself reads them, no locking needed.
+static _Thread_local uint64 TAllocations[MemoryTag_Count];
+static _Thread_local uint64 TFrameStart[MemoryTag_Count];
+
+// stb_ds can allocate before the tracker is initialized, the original functions are looked up on first use.
+static void MemoryGetOriginals(void)
+{
+	if (!GMemory.Malloc) {
+		SDL_GetOriginalMemoryFunctions(&GMemory.Malloc, &GMemory.Calloc, &GMemory.Realloc, &GMemory.Free);
+	}
+}
+
+MemoryTag MemoryResolveTag(MemoryTag DefaultTag)
+{
+	return (TMemoryTag != MemoryTag_Untagged) ? TMemoryTag : DefaultTag;
+}
+
+static void MemoryCount(MemoryTag Tag, int64 Bytes, int64 Count)
+{
+	MemoryTagCounters* Counters = &GMemory.Tags[Tag];
+	SDL_LockSpinlock(&Counters->Lock);
+	Counters->Stats.LiveBytes += Bytes;
+	Counters->Stats.LiveCount += Count;
+	Counters->Stats.PeakBytes = SDL_max(Counters->Stats.PeakBytes, Counters->Stats.LiveBytes);
+	if (Count > 0) {
+		Counters->Stats.TotalCount += Count;
+	}
+	if (Bytes > 0) {
+		Counters->Stats.TotalBytes += Bytes;
+	}
+	SDL_UnlockSpinlock(&Counters->Lock);
+}
+
+void MemoryTrackMapped(MemoryTag Tag, int64 Bytes)
+{
+	ASSERT(VALID_INDEX(Tag, MemoryTag_Count));
+	MemoryCount(Tag, Bytes, (Bytes >= 0) ? 1 : -1);
+	if (Bytes >= 0) {
+		TAllocations[Tag]++;
+	}
+}
+
+static void* MemoryFinish(MemoryHeader* Header, MemoryTag Tag, size_t Size)
+{
+	if (!Header) {
+		return NULL;
+	}
+	Header->Size = Size;
+	Header->Tag = Tag;
+	Header->Magic = MEMORY_HEADER_MAGIC;
+	MemoryCount(Tag, (int64)Size, 1);
+	TAllocations[Tag]++;
+	return Header + 1;
+}
+
+static MemoryHeader* MemoryGetHeader(void* Pointer)
+{
+	MemoryHeader* Header = (MemoryHeader*)Pointer - 1;
+	ASSERT(Header->Magic == MEMORY_HEADER_MAGIC && "Block wasn't allocated through the memory tracker.");
+	return Header;
+}
+
+void* MemoryAlloc(MemoryTag DefaultTag, size_t Size)
+{
+	MemoryGetOriginals();
+	if (Size > SIZE_MAX - sizeof(MemoryHeader)) {
+		return NULL;
+	}
+	return MemoryFinish(GMemory.Malloc(sizeof(MemoryHeader) + Size), MemoryResolveTag(DefaultTag), Size);
+}
+
+static void* MemoryCalloc(MemoryTag DefaultTag, size_t Count, size_t Size)
+{
+	MemoryGetOriginals();
+	if (Size != 0 && Count > (SIZE_MAX - sizeof(MemoryHeader)) / Size) {
+		return NULL;
+	}
+	size_t Bytes = Count * Size;
+	return MemoryFinish(GMemory.Calloc(1, sizeof(MemoryHeader) + Bytes), MemoryResolveTag(DefaultTag), Bytes);
+}
+
+// A block keeps the tag it was first allocated with.
+void* MemoryRealloc(MemoryTag DefaultTag, void* Pointer, size_t Size)
+{
+	if (!Pointer) {
+		return MemoryAlloc(DefaultTag, Size);
+	}
+	if (Size > SIZE_MAX - sizeof(MemoryHeader)) {
+		return NULL;
+	}
+
+	MemoryHeader* Header = MemoryGetHeader(Pointer);
+	MemoryTag Tag = Header->Tag;
+	size_t OldSize = Header->Size;
+	MemoryHeader* Resized = GMemory.Realloc(Header, sizeof(MemoryHeader) + Size);
+	if (!Resized) {
+		return NULL;
+	}
+	Resized->Size = Size;
+	MemoryCount(Tag, (int64)Size - (int64)OldSize, 0);
+	TAllocations[Tag]++;
+	return Resized + 1;
+}
+
+void MemoryFree(void* Pointer)
+{
+	if (!Pointer) {
+		return;
+	}
+	MemoryHeader* Header = MemoryGetHeader(Pointer);
+	MemoryCount(Header->Tag, -(int64)Header->Size, -1);
+	Header->Magic = 0;
+	GMemory.Free(Header);
+}
+
+static void* SDLCALL MemorySDLMalloc(size_t Size)
+{
+	return MemoryAlloc(MemoryTag_Untagged, Size);
+}
+
+static void* SDLCALL MemorySDLCalloc(size_t Count, size_t Size)
+{
+	return MemoryCalloc(MemoryTag_Untagged, Count, Size);
+}
+
+static void* SDLCALL MemorySDLRealloc(void* Pointer, size_t Size)
+{
+	return MemoryRealloc(MemoryTag_Untagged, Pointer, Size);
+}
+
+static void SDLCALL MemorySDLFree(void* Pointer)
+{
+	MemoryFree(Pointer);
+}
+
+void MemoryTrackerInitialize(void)
+{
+	MemoryGetOriginals();
+	GMemory.WindowStartNS = SDL_GetTicksNS();
+	if (!SDL_SetMemoryFunctions(MemorySDLMalloc, MemorySDLCalloc, MemorySDLRealloc, MemorySDLFree)) {
+		PanicAndAbort("Memory Tracker Panic", SDL_GetError());
+	}
+}
+
+void MemoryTrackerUpdate(void)
+{
+	uint64 NowNS = SDL_GetTicksNS();
+	uint64 ElapsedNS = NowNS - GMemory.WindowStartNS;
+	if (ElapsedNS < SDL_NS_PER_SECOND) {
+		return;
+	}
+
+	float32 Seconds = (float32)((float64)ElapsedNS / SDL_NS_PER_SECOND);
+	for (int32 Tag = 0; Tag < MemoryTag_Count; Tag++) {
+		MemoryTagCounters* Counters = &GMemory.Tags[Tag];
+		SDL_LockSpinlock(&Counters->Lock);
+		Counters->Stats.AllocationsPerSecond = (Counters->Stats.TotalCount - Counters->WindowCount) / Seconds;
+		Counters->Stats.BytesPerSecond = (Counters->Stats.TotalBytes - Counters->WindowBytes) / Seconds;
+		Counters->WindowCount = Counters->Stats.TotalCount;
+		Counters->WindowBytes = Counters->Stats.TotalBytes;
+		SDL_UnlockSpinlock(&Counters->Lock);
+	}
+	GMemory.WindowStartNS = NowNS;
+}
+
+void MemoryTrackerGetStats(MemoryTag Tag, MemoryTagStats* OutStats)
+{
+	ASSERT(VALID_INDEX(Tag, MemoryTag_Count));
+	MemoryTagCounters* Counters = &GMemory.Tags[Tag];
+	SDL_LockSpinlock(&Counters->Lock);
+	*OutStats = Counters->Stats;
+	SDL_UnlockSpinlock(&Counters->Lock);
+}
+
+MemoryTag MemoryPushTag(MemoryTag Tag)
+{
+	MemoryTag Previous = TMemoryTag;
+	TMemoryTag = Tag;
+	return Previous;
+}
+
+void MemoryPopTag(MemoryTag Previous)
+{
+	TMemoryTag = Previous;
+}
+
+void MemoryTrackerArmSteadyState(void)
+{
+	if (!GMemory.SteadyState) {
+		GMemory.SteadyState = true;
+		LogInfo("Memory: Steady state, frames are expected not to allocate from here on");
+	}
+}
+
+void MemoryTrackerBeginFrame(void)
+{
+	SDL_memcpy(TFrameStart, TAllocations, sizeof(TFrameStart));
+}
+
+// Logs at most once a second so a frame that allocates every time doesn't flood the log.
+void MemoryTrackerEndFrame(void)
+{
+	if (!GMemory.SteadyState) {
+		return;
+	}
+	GMemory.SteadyFrames++;
+
+	char Tags[256];
+	int32 TagsLength = 0;
+	uint64 FrameCount = 0;
+	for (int32 Tag = 0; Tag < MemoryTag_Count; Tag++) {
+		uint64 Count = TAllocations[Tag] - TFrameStart[Tag];
+		if (Count > 0) {
+			FrameCount += Count;
+			TagsLength += SDL_snprintf(
+				Tags + TagsLength,
+				sizeof(Tags) - TagsLength,
+				"%s%s %llu",
+				(TagsLength > 0) ? ", " : "",
+				MemoryTagNames[Tag],
+				(unsigned long long)Count);
+		}
+	}
+	if (FrameCount == 0) {
+		return;
+	}
+
+	GMemory.AllocatingFrames++;
+	uint64 NowNS = SDL_GetTicksNS();
+	if (GMemory.LastReportNS != 0 && NowNS - GMemory.LastReportNS < SDL_NS_PER_SECOND) {
+		GMemory.SuppressedFrames++;
+	} else {
+		LogWarning(
+			"Memory: Steady state frame made %llu heap allocations (%s), %llu more such frames not logged",
+			(unsigned long long)FrameCount,
+			Tags,
+			(unsigned long long)GMemory.SuppressedFrames);
+		GMemory.SuppressedFrames = 0;
+		GMemory.LastReportNS = NowNS;
+	}
+	ASSERT(!MEMORY_STEADY_STATE_ASSERT && "Heap allocation in a steady state frame.");
+}
+#else
+void MemoryTrackerInitialize(void)
+{
+}
+
+void MemoryTrackerUpdate(void)
+{
+}
+
+void MemoryTrackerGetStats(MemoryTag Tag, MemoryTagStats* OutStats)
+{
+	ZERO_STRUCT(OutStats);
+}
+
+MemoryTag MemoryPushTag(MemoryTag Tag)
+{
+	return MemoryTag_Untagged;
+}
+
+void MemoryPopTag(MemoryTag Previous)
+{
+}
+
+void MemoryTrackerArmSteadyState(void)
+{
+}
+
+void MemoryTrackerBeginFrame(void)
+{
+}
+
+void MemoryTrackerEndFrame(void)
+{
+}
+
+MemoryTag MemoryResolveTag(MemoryTag DefaultTag)
+{
+	return DefaultTag;
+}
+
+void MemoryTrackMapped(MemoryTag Tag, int64 Bytes)
+{
+}
+
+void* MemoryAlloc(MemoryTag DefaultTag, size_t Size)
+{
+	return SDL_malloc(Size);
+}
+
+void* MemoryRealloc(MemoryTag DefaultTag, void* Pointer, size_t Size)
+{
+	return SDL_realloc(Pointer, Size);
+}
+
+void MemoryFree(void* Pointer)
+{
+	SDL_free(Pointer);
+}
+#endif
+
+const char* MemoryTrackerGetTagName(MemoryTag Tag)
+{
+	ASSERT(VALID_INDEX(Tag, MemoryTag_Count));
+	return MemoryTagNames[Tag];
+}
+
+void MemoryTrackerLogSummary(void)
+{
+#if MEMORY_TRACKING
+	LogInfo("Memory: %-12s %10s %10s %10s %12s", "tag", "live KB", "peak KB", "blocks", "allocations");
+	for (int32 Tag = 0; Tag < MemoryTag_Count; Tag++) {
+		MemoryTagStats Stats;
+		MemoryTrackerGetStats(Tag, &Stats);
+		LogInfo(
+			"Memory: %-12s %10lld %10lld %10lld %12llu",
+			MemoryTagNames[Tag],
+			(long long)(Stats.LiveBytes / 1024),
+			(long long)(Stats.PeakBytes / 1024),
+			(long long)Stats.LiveCount,
+			(unsigned long long)Stats.TotalCount);
+	}
+	if (GMemory.SteadyState) {
+		LogInfo(
+			"Memory: %llu of %llu steady state frames allocated",
+			(unsigned long long)GMemory.AllocatingFrames,
+			(unsigned long long)GMemory.SteadyFrames);
+	}
+#endif
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Types.h"
+
+// Heap accounting by subsystem. SDL's allocator is hooked and stb_ds, stb_image and strpool are routed through
+// MemoryAlloc, every block carries a 16 byte header with its size and tag. An allocation takes the calling thread's
+// tag if one is pushed, otherwise the default its call site passes in (untagged for SDL). Compiled into debug builds
+// only, build with MEMORY_TRACKING=1 to keep it in release. Without it the functions forward straight to SDL.
+#ifndef MEMORY_TRACKING
+#ifdef _DEBUG
+#define MEMORY_TRACKING 1
+#else
+#define MEMORY_TRACKING 0
+#endif
+#endif
+
+// Stops in the debugger on a steady state frame that allocated instead of only logging it.
+#ifndef MEMORY_STEADY_STATE_ASSERT
+#define MEMORY_STEADY_STATE_ASSERT 0
+#endif
+
+typedef enum MemoryTag {
+	MemoryTag_Untagged,
+	MemoryTag_Screenshot,
+	MemoryTag_ShavedSurface,
+	MemoryTag_Patterns,
+	MemoryTag_StbDs,
+	MemoryTag_StbImage,
+	MemoryTag_StringPool,
+	MemoryTag_FrameArena,
+	MemoryTag_Count,
+} MemoryTag;
+
+typedef struct MemoryTagStats {
+	int64 LiveBytes;
+	int64 PeakBytes;
+	int64 LiveCount;
+	uint64 TotalCount;
+	uint64 TotalBytes;
+	float32 AllocationsPerSecond; // Over the last full second, see MemoryTrackerUpdate
+	float32 BytesPerSecond;
+} MemoryTagStats;
+
+// Installs the SDL hooks, has to run before SDL allocates anything so every block SDL frees carries a header.
+void MemoryTrackerInitialize(void);
+// Once per frame, refreshes the per second rates.
+void MemoryTrackerUpdate(void);
+void MemoryTrackerGetStats(MemoryTag Tag, MemoryTagStats* OutStats);
+const char* MemoryTrackerGetTagName(MemoryTag Tag);
+void MemoryTrackerLogSummary(void);
+
+// Zero allocation steady state. Once armed, every heap allocation the calling thread makes between BeginFrame and
+// EndFrame is reported with the tags it went to. Workers aren't checked, pattern decodes allocate by design.
+void MemoryTrackerArmSteadyState(void);
+void MemoryTrackerBeginFrame(void);
+void MemoryTrackerEndFrame(void);
+
+// Returns the previous tag so scopes nest, pass it back to MemoryPopTag.
+MemoryTag MemoryPushTag(MemoryTag Tag);
+void MemoryPopTag(MemoryTag Previous);
+
+// The tag a block allocated right now would get, the calling thread's if one is pushed.
+MemoryTag MemoryResolveTag(MemoryTag DefaultTag);
+// Blocks that don't come from the heap (mapped pages) are counted by their owner, negative Bytes when released.
+void MemoryTrackMapped(MemoryTag Tag, int64 Bytes);
+
+void* MemoryAlloc(MemoryTag DefaultTag, size_t Size);
+void* MemoryRealloc(MemoryTag DefaultTag, void* Pointer, size_t Size);
+void MemoryFree(void* Pointer);
@@ -0,0 +1,560 @@
+#include "PatternLibrary.h"
+
+#include <SDL3/SDL.h>
+#include <dir.h>
+#include <sokol_time.h>
+#include <stb_ds.h>
+
+#include "Application.h"
+#include "Jobs.h"
+#include "Log.h"
+#include "MemoryTracker.h"
+
+#if __LINUX__
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+typedef struct PatternSlot {
+	PatternImage Image;
+	uint8* Storage; // Indices followed by the palette when indexed
+	int64 ResidentBytes;
+} PatternSlot;
+
+// Entries are allocated one by one so decode jobs can keep pointing at them while the library grows.
+typedef struct PatternEntry {
+	const char* Name;
+	char* FileName;		// Owned, NULL for built in patterns
+	char* NextFileName; // Source to switch to on the next decode, set when a file replaces the entry
+	const void* Data;
+	size_t Bytes;
+	SDL_Time ModifyTime;
+	PatternSlot Resident;
+	PatternSlot Decoded; // Written by the decode job, only read once Decode is done
+	JobCounter Decode;
+	uint64 DecodeTicks;
+	bool Decoding;
+	bool Stale;	 // The source changed after the in flight decode started
+	bool Failed; // Not retried until the source changes
+	bool Pinned;
+	uint64 LastUsedFrame;
+} PatternEntry;
+
+static struct {
+	PatternEntry** Entries;
+	int64 MemoryBudget;
+	int64 ResidentBytes;
+	uint64 Frame;
+	int32 LastServed;
+	char* Directory;
+#if __LINUX__
+	int Watch;
+#else
+	HANDLE Watch;
+#endif
+} GPatternLibrary;
+
+static bool PatternHasImage(const PatternSlot* Slot)
+{
+	return Slot->Image.Surface != NULL || Slot->Storage != NULL;
+}
+
+// Takes ownership of Surface, replacing it with an indexed copy when every colour fits the palette and is opaque
+// (filling indexed patterns copies where the blit blends). Safe on a worker, it only touches Slot.
+static void PatternSetImage(PatternSlot* Slot, SDL_Surface* Surface, bool Pinned)
+{
+	*Slot = (PatternSlot){0};
+	if (Surface == NULL) {
+		return;
+	}
+	ASSERT(Surface->format == SDL_PIXELFORMAT_RGBA32);
+
+	Slot->Image.Width = Surface->w;
+	Slot->Image.Height = Surface->h;
+
+	// The palette goes after the indices, 4 byte aligned for the gather kernel.
+	int32 ColorsOffset = (Surface->w * Surface->h + 3) & ~3;
+	uint8* Storage = SDL_malloc(ColorsOffset + 256 * sizeof(uint32));
+	int32 ColorCount =
+		IndexPixels(Surface->pixels, Surface->pitch, Surface->w, Surface->h, Storage, (uint32*)(Storage + ColorsOffset));
+
+	bool Indexable = ColorCount > 0;
+	for (int32 Index = 0; Indexable && Index < ColorCount; Index++) {
+		Indexable = ((const uint8*)Storage + ColorsOffset)[Index * 4 + 3] == 0xFF;
+	}
+	if (!Indexable) {
+		SDL_free(Storage);
+		Slot->Image.Surface = Surface;
+		Slot->ResidentBytes = Pinned ? 0 : (int64)Surface->pitch * Surface->h;
+		return;
+	}
+
+	Storage = SDL_realloc(Storage, ColorsOffset + ColorCount * sizeof(uint32));
+	SDL_DestroySurface(Surface);
+	Slot->Storage = Storage;
+	Slot->Image.Indices = Storage;
+	PixelPaletteInitialize(&Slot->Image.Palette, (const uint32*)(Storage + ColorsOffset), ColorCount);
+	Slot->ResidentBytes = ColorsOffset + ColorCount * sizeof(uint32);
+}
+
+static void PatternReleaseSlot(PatternSlot* Slot)
+{
+	SDL_DestroySurface(Slot->Image.Surface);
+	SDL_free(Slot->Storage);
+	*Slot = (PatternSlot){0};
+}
+
+static void DecodePatternJob(void* UserData)
+{
+	PatternEntry* Entry = (PatternEntry*)UserData;
+	MemoryTag PreviousTag = MemoryPushTag(MemoryTag_Patterns);
+	uint64 StartTicks = stm_now();
+	SDL_Surface* Surface = NULL;
+	if (Entry->FileName != NULL) {
+		LoadImage(Entry->FileName, &Surface);
+	} else {
+		LoadImageFromMemory(Entry->Data, Entry->Bytes, &Surface);
+	}
+	PatternSetImage(&Entry->Decoded, Surface, false);
+	Entry->DecodeTicks = stm_since(StartTicks);
+	MemoryPopTag(PreviousTag);
+}
+
+static const char* PatternBaseName(const char* FileName)
+{
+	const char* Separator = SDL_strrchr(FileName, '/');
+	return (Separator != NULL) ? Separator + 1 : FileName;
+}
+
+// Decodes never run on the calling thread. With the queue full the entry stays as it is and the decode is retried by
+// the next prefetch, or by PatternLibraryUpdate for a changed file.
+static void PatternStartDecode(PatternEntry* Entry)
+{
+	ASSERT(!Entry->Decoding);
+
+	// The job reads the source, so it may only be switched while nothing is in flight.
+	if (Entry->NextFileName != NULL) {
+		SDL_free(Entry->FileName);
+		Entry->FileName = Entry->NextFileName;
+		Entry->NextFileName = NULL;
+		Entry->Name = PatternBaseName(Entry->FileName);
+		Entry->Data = NULL;
+		Entry->Bytes = 0;
+	}
+
+	if (JobsTrySubmit(DecodePatternJob, Entry, &Entry->Decode)) {
+		Entry->Stale = false;
+		Entry->Decoding = true;
+	}
+}
+
+// A changed file is decoded right away when it replaces a resident image or fits in the budget.
+static bool PatternWantsReload(const PatternEntry* Entry)
+{
+	return Entry->Stale && !Entry->Decoding &&
+		   (PatternHasImage(&Entry->Resident) || GPatternLibrary.ResidentBytes < GPatternLibrary.MemoryBudget);
+}
+
+static void PatternDecodeFinished(PatternEntry* Entry)
+{
+	Entry->Decoding = false;
+	if (!PatternHasImage(&Entry->Decoded)) {
+		LogError("Patterns: Unable to decode %s", (Entry->FileName != NULL) ? Entry->FileName : Entry->Name);
+		Entry->Failed = !Entry->Stale;
+	} else {
+		bool Replaced = PatternHasImage(&Entry->Resident);
+		GPatternLibrary.ResidentBytes -= Entry->Resident.ResidentBytes;
+		PatternReleaseSlot(&Entry->Resident);
+		Entry->Resident = Entry->Decoded;
+		Entry->Decoded = (PatternSlot){0};
+		Entry->Pinned = false;
+		GPatternLibrary.ResidentBytes += Entry->Resident.ResidentBytes;
+		LogInfo(
+			"Patterns: %s %s (%dx%d, %s) in %.2f ms, %" SDL_PRIs64 " KB resident",
+			Replaced ? "Reloaded" : "Decoded",
+			Entry->Name,
+			Entry->Resident.Image.Width,
+			Entry->Resident.Image.Height,
+			(Entry->Resident.Storage != NULL) ? "indexed" : "RGBA32",
+			stm_ms(Entry->DecodeTicks),
+			GPatternLibrary.ResidentBytes / 1024);
+	}
+
+	if (Entry->Stale) {
+		PatternStartDecode(Entry);
+	}
+}
+
+static PatternEntry* PatternAddEntry(const char* Name)
+{
+	PatternEntry* Entry = SDL_calloc(1, sizeof(PatternEntry));
+	Entry->Name = Name;
+	arrput(GPatternLibrary.Entries, Entry);
+	return Entry;
+}
+
+static PatternEntry* PatternFind(const char* Name)
+{
+	for (int32 Index = 0; Index < arrlen(GPatternLibrary.Entries); Index++) {
+		if (SDL_strcmp(GPatternLibrary.Entries[Index]->Name, Name) == 0) {
+			return GPatternLibrary.Entries[Index];
+		}
+	}
+	return NULL;
+}
+
+// Points Entry at FileName. A resident entry is decoded again right away so the new version shows up on its next use,
+// the old image stays in place until then.
+static void PatternSourceChanged(PatternEntry* Entry, const char* FileName)
+{
+	const char* Source = (Entry->NextFileName != NULL) ? Entry->NextFileName : Entry->FileName;
+	if (Source == NULL || SDL_strcmp(Source, FileName) != 0) {
+		SDL_free(Entry->NextFileName);
+		Entry->NextFileName = SDL_strdup(FileName);
+	}
+
+	Entry->Stale = true;
+	Entry->Failed = false;
+	if (PatternWantsReload(Entry)) {
+		PatternStartDecode(Entry);
+	}
+}
+
+static void PatternScanFile(const char* Name)
+{
+	const char* Extension = SDL_strrchr(Name, '.');
+	if (Extension == NULL || SDL_strcasecmp(Extension, ".png") != 0) {
+		return;
+	}
+
+	char FileName[1024];
+	SDL_snprintf(FileName, sizeof(FileName), "%s/%s", GPatternLibrary.Directory, Name);
+	SDL_PathInfo Info;
+	if (!SDL_GetPathInfo(FileName, &Info) || Info.type != SDL_PATHTYPE_FILE) {
+		return;
+	}
+
+	PatternEntry* Entry = PatternFind(Name);
+	if (Entry != NULL && Entry->ModifyTime == Info.modify_time) {
+		return;
+	}
+
+	if (Entry == NULL) {
+		Entry = PatternAddEntry(NULL);
+		PatternSourceChanged(Entry, FileName);
+		Entry->Name = PatternBaseName((Entry->FileName != NULL) ? Entry->FileName : Entry->NextFileName);
+		LogInfo("Patterns: Added %s as pattern %d", FileName, arrlen(GPatternLibrary.Entries) - 1);
+	} else {
+		LogInfo("Patterns: %s changed", FileName);
+		PatternSourceChanged(Entry, FileName);
+	}
+	Entry->ModifyTime = Info.modify_time;
+}
+
+static int PatternCompareNames(const void* A, const void* B)
+{
+	return SDL_strcmp(*(char* const*)A, *(char* const*)B);
+}
+
+// Listing order depends on the file system, sorting keeps pattern indices the same from run to run.
+static void PatternScanDirectory(void)
+{
+	dir_t* Directory = dir_open(GPatternLibrary.Directory);
+	if (Directory == NULL) {
+		return;
+	}
+
+	char** Names = NULL;
+	for (dir_entry_t* DirEntry = dir_read(Directory); DirEntry != NULL; DirEntry = dir_read(Directory)) {
+		if (dir_is_file(DirEntry)) {
+			arrput(Names, SDL_strdup(dir_name(DirEntry)));
+		}
+	}
+	dir_close(Directory);
+
+	SDL_qsort(Names, arrlen(Names), sizeof(char*), PatternCompareNames);
+	for (int32 Index = 0; Index < arrlen(Names); Index++) {
+		PatternScanFile(Names[Index]);
+		SDL_free(Names[Index]);
+	}
+	arrfree(Names);
+}
+
+// Only whole files are picked up: close after write and renames into the directory, never partial writes.
+static void PatternPollDirectory(void)
+{
+#if __LINUX__
+	if (GPatternLibrary.Watch < 0) {
+		return;
+	}
+
+	_Alignas(struct inotify_event) char Buffer[4096];
+	bool Overflowed = false;
+	ssize_t Length;
+	while ((Length = read(GPatternLibrary.Watch, Buffer, sizeof(Buffer))) > 0) {
+		for (char* Cursor = Buffer; Cursor < Buffer + Length;) {
+			const struct inotify_event* Event = (const struct inotify_event*)Cursor;
+			if (Event->mask & IN_Q_OVERFLOW) {
+				Overflowed = true;
+			} else if (Event->len > 0 && !(Event->mask & IN_ISDIR)) {
+				PatternScanFile(Event->name);
+			}
+			Cursor += sizeof(struct inotify_event) + Event->len;
+		}
+	}
+
+	if (Overflowed) {
+		PatternScanDirectory();
+	}
+#else
+	if (GPatternLibrary.Watch == NULL || WaitForSingleObject(GPatternLibrary.Watch, 0) != WAIT_OBJECT_0) {
+		return;
+	}
+
+	// Re-arm first so changes made during the scan trigger another one. Half written files fail to decode and are
+	// retried on the write that completes them.
+	FindNextChangeNotification(GPatternLibrary.Watch);
+	PatternScanDirectory();
+#endif
+}
+
+void PatternLibraryInitialize(int64 MemoryBudget)
+{
+	SDL_zero(GPatternLibrary);
+	GPatternLibrary.MemoryBudget = MemoryBudget;
+	GPatternLibrary.LastServed = -1;
+#if __LINUX__
+	GPatternLibrary.Watch = -1;
+#endif
+}
+
+void PatternLibraryShutdown(void)
+{
+#if __LINUX__
+	if (GPatternLibrary.Watch >= 0) {
+		close(GPatternLibrary.Watch);
+	}
+#else
+	if (GPatternLibrary.Watch != NULL) {
+		FindCloseChangeNotification(GPatternLibrary.Watch);
+	}
+#endif
+
+	for (int32 Index = 0; Index < arrlen(GPatternLibrary.Entries); Index++) {
+		PatternEntry* Entry = GPatternLibrary.Entries[Index];
+		JobsWait(&Entry->Decode);
+		PatternReleaseSlot(&Entry->Resident);
+		PatternReleaseSlot(&Entry->Decoded);
+		SDL_free(Entry->FileName);
+		SDL_free(Entry->NextFileName);
+		SDL_free(Entry);
+	}
+	arrfree(GPatternLibrary.Entries);
+	SDL_free(GPatternLibrary.Directory);
+	SDL_zero(GPatternLibrary);
+}
+
+void PatternLibrarySetMemoryBudget(int64 MemoryBudget)
+{
+	GPatternLibrary.MemoryBudget = MemoryBudget;
+	LogInfo("Patterns: Memory budget %" SDL_PRIs64 " KB", MemoryBudget / 1024);
+}
+
+int32 PatternLibraryAdd(const char* Name, const void* Data, size_t Bytes)
+{
+	PatternEntry* Entry = PatternAddEntry(Name);
+	Entry->Data = Data;
+	Entry->Bytes = Bytes;
+	return arrlen(GPatternLibrary.Entries) - 1;
+}
+
+int32 PatternLibraryAddSurface(const char* Name, SDL_Surface* Surface)
+{
+	PatternEntry* Entry = PatternAddEntry(Name);
+	Entry->Pinned = true;
+	MemoryTag PreviousTag = MemoryPushTag(MemoryTag_Patterns);
+	PatternSetImage(&Entry->Resident, Surface, true);
+	MemoryPopTag(PreviousTag);
+	GPatternLibrary.ResidentBytes += Entry->Resident.ResidentBytes;
+	return arrlen(GPatternLibrary.Entries) - 1;
+}
+
+int32 PatternLibraryGetCount(void)
+{
+	return arrlen(GPatternLibrary.Entries);
+}
+
+void PatternLibraryWatchDirectory(const char* Directory)
+{
+	ASSERT(GPatternLibrary.Directory == NULL);
+	GPatternLibrary.Directory = SDL_strdup(Directory);
+
+	int32 BuiltInCount = arrlen(GPatternLibrary.Entries);
+	PatternScanDirectory();
+
+#if __LINUX__
+	GPatternLibrary.Watch = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (GPatternLibrary.Watch >= 0 &&
+		inotify_add_watch(GPatternLibrary.Watch, Directory, IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+	{
+		close(GPatternLibrary.Watch);
+		GPatternLibrary.Watch = -1;
+	}
+	bool Watching = GPatternLibrary.Watch >= 0;
+#else
+	GPatternLibrary.Watch =
+		FindFirstChangeNotificationA(Directory, FALSE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE);
+	if (GPatternLibrary.Watch == INVALID_HANDLE_VALUE) {
+		GPatternLibrary.Watch = NULL;
+	}
+	bool Watching = GPatternLibrary.Watch != NULL;
+#endif
+
+	LogInfo(
+		"Patterns: %d patterns from %s, %s",
+		arrlen(GPatternLibrary.Entries) - BuiltInCount,
+		Directory,
+		Watching ? "watching for changes" : "not watched");
+}
+
+void PatternLibraryUpdate(void)
+{
+	PatternPollDirectory();
+
+	for (int32 Index = 0; Index < arrlen(GPatternLibrary.Entries); Index++) {
+		PatternEntry* Entry = GPatternLibrary.Entries[Index];
+		if (Entry->Decoding && JobsIsDone(&Entry->Decode)) {
+			PatternDecodeFinished(Entry);
+		} else if (PatternWantsReload(Entry)) {
+			PatternStartDecode(Entry);
+		}
+	}
+
+	// Entries touched since the previous update are still in use, only older ones are candidates.
+	while (GPatternLibrary.ResidentBytes > GPatternLibrary.MemoryBudget) {
+		PatternEntry* Oldest = NULL;
+		for (int32 Index = 0; Index < arrlen(GPatternLibrary.Entries); Index++) {
+			PatternEntry* Entry = GPatternLibrary.Entries[Index];
+			if (PatternHasImage(&Entry->Resident) && !Entry->Pinned && Entry->LastUsedFrame < GPatternLibrary.Frame &&
+				(Oldest == NULL || Entry->LastUsedFrame < Oldest->LastUsedFrame))
+			{
+				Oldest = Entry;
+			}
+		}
+		if (Oldest == NULL) {
+			break;
+		}
+
+		LogVerbose("Patterns: Evicting %s", Oldest->Name);
+		GPatternLibrary.ResidentBytes -= Oldest->Resident.ResidentBytes;
+		PatternReleaseSlot(&Oldest->Resident);
+	}
+
+	GPatternLibrary.Frame++;
+}
+
+void PatternLibraryTouch(int32 Index)
+{
+	ASSERT(VALID_INDEX(Index, arrlen(GPatternLibrary.Entries)));
+	GPatternLibrary.Entries[Index]->LastUsedFrame = GPatternLibrary.Frame;
+}
+
+void PatternLibraryPrefetch(int32 Index)
+{
+	PatternLibraryTouch(Index);
+
+	PatternEntry* Entry = GPatternLibrary.Entries[Index];
+	if (!PatternHasImage(&Entry->Resident) && !Entry->Decoding && !Entry->Failed) {
+		PatternStartDecode(Entry);
+	}
+}
+
+const PatternImage* PatternLibraryGet(int32 Index)
+{
+	PatternLibraryPrefetch(Index);
+
+	PatternEntry* Entry = GPatternLibrary.Entries[Index];
+	if (PatternHasImage(&Entry->Resident)) {
+		GPatternLibrary.LastServed = Index;
+		return &Entry->Resident.Image;
+	}
+
+	// Still decoding (prefetch didn't get to it, or it was evicted mid cycle), the frame carries on with another.
+	int32 Fallback = GPatternLibrary.LastServed;
+	if (Fallback < 0 || !PatternHasImage(&GPatternLibrary.Entries[Fallback]->Resident)) {
+		for (Fallback = 0; Fallback < arrlen(GPatternLibrary.Entries); Fallback++) {
+			if (PatternHasImage(&GPatternLibrary.Entries[Fallback]->Resident)) {
+				break;
+			}
+		}
+		if (Fallback == arrlen(GPatternLibrary.Entries)) {
+			return NULL;
+		}
+	}
+
+	PatternLibraryTouch(Fallback);
+	return &GPatternLibrary.Entries[Fallback]->Resident.Image;
+}
+
+int64 PatternLibraryGetResidentBytes(void)
+{
+	return GPatternLibrary.ResidentBytes;
+}
+
+int32 PatternLibraryGetResidentCount(void)
+{
+	int32 Count = 0;
+	for (int32 Index = 0; Index < arrlen(GPatternLibrary.Entries); Index++) {
+		Count += PatternHasImage(&GPatternLibrary.Entries[Index]->Resident) ? 1 : 0;
+	}
+	return Count;
+}
+
+// Stack room for an index row repeated across the fill, each expand call then covers many tiles instead of one.
+#define PATTERN_FILL_SPAN 512
+
+void PatternFill(const PatternImage* Pattern, SDL_Surface* Dest, int32 Left, int32 Top, int32 Right, int32 Bottom)
+{
+	ASSERT(Dest->format == SDL_PIXELFORMAT_RGBA32);
+	ASSERT(Left >= 0 && Top >= 0 && Right <= Dest->w && Bottom <= Dest->h);
+
+	if (Pattern->Surface != NULL) {
+		for (int32 TileY = Top; TileY < Bottom; TileY += Pattern->Height) {
+			for (int32 TileX = Left; TileX < Right; TileX += Pattern->Width) {
+				int32 TileWidth = SDL_min(Pattern->Width, Right - TileX);
+				int32 TileHeight = SDL_min(Pattern->Height, Bottom - TileY);
+				SDL_BlitSurface(
+					Pattern->Surface,
+					&(SDL_Rect){0, 0, TileWidth, TileHeight},
+					Dest,
+					&(SDL_Rect){TileX, TileY, TileWidth, TileHeight});
+			}
+		}
+		return;
+	}
+
+	// The span is a whole number of tiles so the pattern's phase carries over from one span to the next.
+	uint8 RepeatedRow[PATTERN_FILL_SPAN];
+	bool Repeat = Pattern->Width <= PATTERN_FILL_SPAN / 2;
+	int32 Span = Repeat ? PATTERN_FILL_SPAN / Pattern->Width * Pattern->Width : Pattern->Width;
+
+	for (int32 Row = 0; Row < Pattern->Height && Top + Row < Bottom; Row++) {
+		const uint8* Indices = Pattern->Indices + Row * Pattern->Width;
+		if (Repeat) {
+			for (int32 X = 0; X < Span; X += Pattern->Width) {
+				SDL_memcpy(RepeatedRow + X, Indices, Pattern->Width);
+			}
+			Indices = RepeatedRow;
+		}
+
+		for (int32 Y = Top + Row; Y < Bottom; Y += Pattern->Height) {
+			uint8* DestRow = (uint8*)Dest->pixels + (ptrdiff_t)Y * Dest->pitch;
+			for (int32 X = Left; X < Right; X += Span) {
+				ExpandIndexedPixels(Indices, &Pattern->Palette, DestRow + X * 4, SDL_min(Span, Right - X));
+			}
+		}
+	}
+}
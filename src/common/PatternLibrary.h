@@ -0,0 +1,61 @@
+#pragma once
+
+#include "PixelConvert.h"
+#include "Types.h"
+
+// Patterns stay in their compressed (embedded PNG) form until first needed. Decoded surfaces are kept resident under a
+// memory budget and evicted least recently used first, entries in use during the current frame are never evicted so
+// the budget is soft. All functions are main thread only, decoding only ever happens on job workers: decodes are
+// queued with JobsTrySubmit and wait for the next try when the queue is full, and no JobsWait on another counter
+// picks them up.
+//
+// Besides the built in patterns, *.png files in a watched directory are picked up at runtime. New files are added to
+// the end of the library and a changed file replaces its entry (or the built in pattern of the same name) once the new
+// version has decoded, the old image keeps being used until then. Deleted files are not removed.
+//
+// Patterns with at most 256 colours, all opaque, are stored 8-bit indexed and expanded while filling, a quarter of the
+// memory and source bandwidth of RGBA32. Anything else keeps its decoded surface and is blitted.
+
+typedef struct SDL_Surface SDL_Surface;
+
+typedef struct PatternImage {
+	int32 Width;
+	int32 Height;
+	SDL_Surface* Surface; // RGBA32, NULL when indexed
+	const uint8* Indices; // Width * Height, rows tightly packed
+	PixelPalette Palette;
+} PatternImage;
+
+void PatternLibraryInitialize(int64 MemoryBudget);
+void PatternLibraryShutdown(void);
+void PatternLibrarySetMemoryBudget(int64 MemoryBudget);
+
+// Data isn't copied and must outlive the library, meant for #embed data.
+int32 PatternLibraryAdd(const char* Name, const void* Data, size_t Bytes);
+// Adds an already decoded pattern, e.g. one mapped from an asset pack. The library takes ownership of the surface, it
+// is pinned resident. Only an indexed copy counts against the budget, the surface's pixels are backed by the file.
+int32 PatternLibraryAddSurface(const char* Name, SDL_Surface* Surface);
+int32 PatternLibraryGetCount(void);
+
+// Adds every pattern in Directory and watches it for added or rewritten files, picked up in PatternLibraryUpdate.
+// Patterns found here decode right away while there's room in the budget, the rest when first prefetched.
+void PatternLibraryWatchDirectory(const char* Directory);
+
+// Picks up directory changes, collects finished decodes and evicts down to the budget, call once per frame before
+// using any pattern.
+void PatternLibraryUpdate(void);
+
+// Marks Index as in use this frame so it survives eviction without decoding it.
+void PatternLibraryTouch(int32 Index);
+// Touch, and queue decoding Index for a worker if it isn't resident or in flight yet.
+void PatternLibraryPrefetch(int32 Index);
+// Touch and return the decoded pattern. Never waits or decodes: when Index isn't resident yet it is prefetched and the
+// most recently returned resident pattern stands in. NULL when nothing is resident, otherwise valid until the next
+// PatternLibraryUpdate.
+const PatternImage* PatternLibraryGet(int32 Index);
+
+// Tiles Pattern over [Left, Right) x [Top, Bottom) of an RGBA32 surface, with the pattern's origin at (Left, Top).
+void PatternFill(const PatternImage* Pattern, SDL_Surface* Dest, int32 Left, int32 Top, int32 Right, int32 Bottom);
+
+int64 PatternLibraryGetResidentBytes(void);
+int32 PatternLibraryGetResidentCount(void);
@@ -0,0 +1,574 @@
+#include "PixelConvert.h"
+
+#include <SDL3/SDL.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PIXEL_CONVERT_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define PIXEL_CONVERT_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__)
+#define PIXEL_CONVERT_TARGET(Target) __attribute__((target(Target)))
+#else
+#define PIXEL_CONVERT_TARGET(Target)
+#endif
+
+_Static_assert(SDL_BYTEORDER == SDL_LIL_ENDIAN, "PixelConvert byte shuffles assume a little endian target");
+
+// Every supported 32-bit source is a fixed byte permutation of RGBA plus an optional forced alpha, so a row kernel
+// only needs the 4 byte shuffle and the alpha mask.
+typedef struct SwizzleDesc {
+	uint8 Shuffle[4]; // Destination byte N takes source byte Shuffle[N]
+	uint32 AlphaMask; // OR'd into every destination pixel
+} SwizzleDesc;
+
+typedef void (*SwizzleRowFunc)(const uint8* Source, uint8* Dest, int32 Width, const SwizzleDesc* Desc);
+
+static void SwizzleRowScalar(const uint8* Source, uint8* Dest, int32 Width, const SwizzleDesc* Desc)
+{
+	const uint32 Shift0 = Desc->Shuffle[0] * 8, Shift1 = Desc->Shuffle[1] * 8;
+	const uint32 Shift2 = Desc->Shuffle[2] * 8, Shift3 = Desc->Shuffle[3] * 8;
+	const uint32 AlphaMask = Desc->AlphaMask;
+
+	for (int32 X = 0; X < Width; X++, Source += 4, Dest += 4) {
+		uint32 In;
+		memcpy(&In, Source, 4);
+		uint32 Out = ((In >> Shift0) & 0xFF) | (((In >> Shift1) & 0xFF) << 8) | (((In >> Shift2) & 0xFF) << 16) |
+					 (((In >> Shift3) & 0xFF) << 24);
+		Out |= AlphaMask;
+		memcpy(Dest, &Out, 4);
+	}
+}
+
+#if PIXEL_CONVERT_X86
+PIXEL_CONVERT_TARGET("ssse3")
+static void SwizzleRowSSSE3(const uint8* Source, uint8* Dest, int32 Width, const SwizzleDesc* Desc)
+{
+	const __m128i Shuffle = _mm_setr_epi8(
+		Desc->Shuffle[0], Desc->Shuffle[1], Desc->Shuffle[2], Desc->Shuffle[3],
+		Desc->Shuffle[0] + 4, Desc->Shuffle[1] + 4, Desc->Shuffle[2] + 4, Desc->Shuffle[3] + 4,
+		Desc->Shuffle[0] + 8, Desc->Shuffle[1] + 8, Desc->Shuffle[2] + 8, Desc->Shuffle[3] + 8,
+		Desc->Shuffle[0] + 12, Desc->Shuffle[1] + 12, Desc->Shuffle[2] + 12, Desc->Shuffle[3] + 12);
+	const __m128i Alpha = _mm_set1_epi32((int)Desc->AlphaMask);
+
+	int32 X = 0;
+	for (; X + 16 <= Width; X += 16) {
+		__m128i A = _mm_loadu_si128((const __m128i*)(Source + X * 4));
+		__m128i B = _mm_loadu_si128((const __m128i*)(Source + X * 4 + 16));
+		__m128i C = _mm_loadu_si128((const __m128i*)(Source + X * 4 + 32));
+		__m128i D = _mm_loadu_si128((const __m128i*)(Source + X * 4 + 48));
+		_mm_storeu_si128((__m128i*)(Dest + X * 4), _mm_or_si128(_mm_shuffle_epi8(A, Shuffle), Alpha));
+		_mm_storeu_si128((__m128i*)(Dest + X * 4 + 16), _mm_or_si128(_mm_shuffle_epi8(B, Shuffle), Alpha));
+		_mm_storeu_si128((__m128i*)(Dest + X * 4 + 32), _mm_or_si128(_mm_shuffle_epi8(C, Shuffle), Alpha));
+		_mm_storeu_si128((__m128i*)(Dest + X * 4 + 48), _mm_or_si128(_mm_shuffle_epi8(D, Shuffle), Alpha));
+	}
+	for (; X + 4 <= Width; X += 4) {
+		__m128i A = _mm_loadu_si128((const __m128i*)(Source + X * 4));
+		_mm_storeu_si128((__m128i*)(Dest + X * 4), _mm_or_si128(_mm_shuffle_epi8(A, Shuffle), Alpha));
+	}
+	SwizzleRowScalar(Source + X * 4, Dest + X * 4, Width - X, Desc);
+}
+
+PIXEL_CONVERT_TARGET("avx2")
+static void SwizzleRowAVX2(const uint8* Source, uint8* Dest, int32 Width, const SwizzleDesc* Desc)
+{
+	// vpshufb shuffles within each 128-bit lane which is exactly what a repeating per-pixel permutation needs.
+	const __m256i Shuffle = _mm256_setr_epi8(
+		Desc->Shuffle[0], Desc->Shuffle[1], Desc->Shuffle[2], Desc->Shuffle[3],
+		Desc->Shuffle[0] + 4, Desc->Shuffle[1] + 4, Desc->Shuffle[2] + 4, Desc->Shuffle[3] + 4,
+		Desc->Shuffle[0] + 8, Desc->Shuffle[1] + 8, Desc->Shuffle[2] + 8, Desc->Shuffle[3] + 8,
+		Desc->Shuffle[0] + 12, Desc->Shuffle[1] + 12, Desc->Shuffle[2] + 12, Desc->Shuffle[3] + 12,
+		Desc->Shuffle[0], Desc->Shuffle[1], Desc->Shuffle[2], Desc->Shuffle[3],
+		Desc->Shuffle[0] + 4, Desc->Shuffle[1] + 4, Desc->Shuffle[2] + 4, Desc->Shuffle[3] + 4,
+		Desc->Shuffle[0] + 8, Desc->Shuffle[1] + 8, Desc->Shuffle[2] + 8, Desc->Shuffle[3] + 8,
+		Desc->Shuffle[0] + 12, Desc->Shuffle[1] + 12, Desc->Shuffle[2] + 12, Desc->Shuffle[3] + 12);
+	const __m256i Alpha = _mm256_set1_epi32((int)Desc->AlphaMask);
+
+	int32 X = 0;
+	for (; X + 32 <= Width; X += 32) {
+		__m256i A = _mm256_loadu_si256((const __m256i*)(Source + X * 4));
+		__m256i B = _mm256_loadu_si256((const __m256i*)(Source + X * 4 + 32));
+		__m256i C = _mm256_loadu_si256((const __m256i*)(Source + X * 4 + 64));
+		__m256i D = _mm256_loadu_si256((const __m256i*)(Source + X * 4 + 96));
+		_mm256_storeu_si256((__m256i*)(Dest + X * 4), _mm256_or_si256(_mm256_shuffle_epi8(A, Shuffle), Alpha));
+		_mm256_storeu_si256((__m256i*)(Dest + X * 4 + 32), _mm256_or_si256(_mm256_shuffle_epi8(B, Shuffle), Alpha));
+		_mm256_storeu_si256((__m256i*)(Dest + X * 4 + 64), _mm256_or_si256(_mm256_shuffle_epi8(C, Shuffle), Alpha));
+		_mm256_storeu_si256((__m256i*)(Dest + X * 4 + 96), _mm256_or_si256(_mm256_shuffle_epi8(D, Shuffle), Alpha));
+	}
+	for (; X + 8 <= Width; X += 8) {
+		__m256i A = _mm256_loadu_si256((const __m256i*)(Source + X * 4));
+		_mm256_storeu_si256((__m256i*)(Dest + X * 4), _mm256_or_si256(_mm256_shuffle_epi8(A, Shuffle), Alpha));
+	}
+	SwizzleRowScalar(Source + X * 4, Dest + X * 4, Width - X, Desc);
+}
+#endif
+
+#if PIXEL_CONVERT_NEON
+static void SwizzleRowNEON(const uint8* Source, uint8* Dest, int32 Width, const SwizzleDesc* Desc)
+{
+	const uint8 ShuffleBytes[16] = {
+		Desc->Shuffle[0], Desc->Shuffle[1], Desc->Shuffle[2], Desc->Shuffle[3],
+		Desc->Shuffle[0] + 4, Desc->Shuffle[1] + 4, Desc->Shuffle[2] + 4, Desc->Shuffle[3] + 4,
+		Desc->Shuffle[0] + 8, Desc->Shuffle[1] + 8, Desc->Shuffle[2] + 8, Desc->Shuffle[3] + 8,
+		Desc->Shuffle[0] + 12, Desc->Shuffle[1] + 12, Desc->Shuffle[2] + 12, Desc->Shuffle[3] + 12,
+	};
+	const uint8x16_t Shuffle = vld1q_u8(ShuffleBytes);
+	const uint8x16_t Alpha = vreinterpretq_u8_u32(vdupq_n_u32(Desc->AlphaMask));
+
+	int32 X = 0;
+	for (; X + 4 <= Width; X += 4) {
+		uint8x16_t A = vld1q_u8(Source + X * 4);
+		vst1q_u8(Dest + X * 4, vorrq_u8(vqtbl1q_u8(A, Shuffle), Alpha));
+	}
+	SwizzleRowScalar(Source + X * 4, Dest + X * 4, Width - X, Desc);
+}
+#endif
+
+// Box downsample rows take two adjacent source rows and write one destination row of Width pixels, each channel being
+// the rounded average (A + B + C + D + 2) / 4 of its 2x2 source block.
+typedef void (*DownsampleRowFunc)(const uint8* Row0, const uint8* Row1, uint8* Dest, int32 Width);
+
+static void DownsampleRowScalar(const uint8* Row0, const uint8* Row1, uint8* Dest, int32 Width)
+{
+	for (int32 X = 0; X < Width; X++, Row0 += 8, Row1 += 8, Dest += 4) {
+		for (int32 Channel = 0; Channel < 4; Channel++) {
+			Dest[Channel] = (uint8)((Row0[Channel] + Row0[Channel + 4] + Row1[Channel] + Row1[Channel + 4] + 2) >> 2);
+		}
+	}
+}
+
+#if PIXEL_CONVERT_X86
+// Only needs SSE2 but shares the SSSE3 kernel slot, every CPU that passes that check has it.
+static void DownsampleRowSSE2(const uint8* Row0, const uint8* Row1, uint8* Dest, int32 Width)
+{
+	const __m128i Zero = _mm_setzero_si128();
+	const __m128i Round = _mm_set1_epi16(2);
+
+	int32 X = 0;
+	for (; X + 4 <= Width; X += 4) {
+		// Split 8 source pixels into even and odd columns, the 2x2 block is then a lane wise sum of four vectors.
+		__m128 A0 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(Row0 + X * 8)));
+		__m128 B0 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(Row0 + X * 8 + 16)));
+		__m128 A1 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(Row1 + X * 8)));
+		__m128 B1 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(Row1 + X * 8 + 16)));
+		__m128i Even0 = _mm_castps_si128(_mm_shuffle_ps(A0, B0, _MM_SHUFFLE(2, 0, 2, 0)));
+		__m128i Odd0 = _mm_castps_si128(_mm_shuffle_ps(A0, B0, _MM_SHUFFLE(3, 1, 3, 1)));
+		__m128i Even1 = _mm_castps_si128(_mm_shuffle_ps(A1, B1, _MM_SHUFFLE(2, 0, 2, 0)));
+		__m128i Odd1 = _mm_castps_si128(_mm_shuffle_ps(A1, B1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+		__m128i Low = _mm_add_epi16(
+			_mm_add_epi16(_mm_unpacklo_epi8(Even0, Zero), _mm_unpacklo_epi8(Odd0, Zero)),
+			_mm_add_epi16(_mm_unpacklo_epi8(Even1, Zero), _mm_unpacklo_epi8(Odd1, Zero)));
+		__m128i High = _mm_add_epi16(
+			_mm_add_epi16(_mm_unpackhi_epi8(Even0, Zero), _mm_unpackhi_epi8(Odd0, Zero)),
+			_mm_add_epi16(_mm_unpackhi_epi8(Even1, Zero), _mm_unpackhi_epi8(Odd1, Zero)));
+		Low = _mm_srli_epi16(_mm_add_epi16(Low, Round), 2);
+		High = _mm_srli_epi16(_mm_add_epi16(High, Round), 2);
+
+		_mm_storeu_si128((__m128i*)(Dest + X * 4), _mm_packus_epi16(Low, High));
+	}
+	DownsampleRowScalar(Row0 + X * 8, Row1 + X * 8, Dest + X * 4, Width - X);
+}
+
+PIXEL_CONVERT_TARGET("avx2")
+static void DownsampleRowAVX2(const uint8* Row0, const uint8* Row1, uint8* Dest, int32 Width)
+{
+	const __m256i Zero = _mm256_setzero_si256();
+	const __m256i Round = _mm256_set1_epi16(2);
+
+	int32 X = 0;
+	for (; X + 8 <= Width; X += 8) {
+		__m256 A0 = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(Row0 + X * 8)));
+		__m256 B0 = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(Row0 + X * 8 + 32)));
+		__m256 A1 = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(Row1 + X * 8)));
+		__m256 B1 = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(Row1 + X * 8 + 32)));
+		__m256i Even0 = _mm256_castps_si256(_mm256_shuffle_ps(A0, B0, _MM_SHUFFLE(2, 0, 2, 0)));
+		__m256i Odd0 = _mm256_castps_si256(_mm256_shuffle_ps(A0, B0, _MM_SHUFFLE(3, 1, 3, 1)));
+		__m256i Even1 = _mm256_castps_si256(_mm256_shuffle_ps(A1, B1, _MM_SHUFFLE(2, 0, 2, 0)));
+		__m256i Odd1 = _mm256_castps_si256(_mm256_shuffle_ps(A1, B1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+		__m256i Low = _mm256_add_epi16(
+			_mm256_add_epi16(_mm256_unpacklo_epi8(Even0, Zero), _mm256_unpacklo_epi8(Odd0, Zero)),
+			_mm256_add_epi16(_mm256_unpacklo_epi8(Even1, Zero), _mm256_unpacklo_epi8(Odd1, Zero)));
+		__m256i High = _mm256_add_epi16(
+			_mm256_add_epi16(_mm256_unpackhi_epi8(Even0, Zero), _mm256_unpackhi_epi8(Odd0, Zero)),
+			_mm256_add_epi16(_mm256_unpackhi_epi8(Even1, Zero), _mm256_unpackhi_epi8(Odd1, Zero)));
+		Low = _mm256_srli_epi16(_mm256_add_epi16(Low, Round), 2);
+		High = _mm256_srli_epi16(_mm256_add_epi16(High, Round), 2);
+
+		// Shuffles work per 128-bit lane so output pairs come out as 0 1 4 5 | 2 3 6 7, put them back in order.
+		__m256i Packed = _mm256_packus_epi16(Low, High);
+		_mm256_storeu_si256((__m256i*)(Dest + X * 4), _mm256_permute4x64_epi64(Packed, _MM_SHUFFLE(3, 1, 2, 0)));
+	}
+	DownsampleRowSSE2(Row0 + X * 8, Row1 + X * 8, Dest + X * 4, Width - X);
+}
+#endif
+
+#if PIXEL_CONVERT_NEON
+static void DownsampleRowNEON(const uint8* Row0, const uint8* Row1, uint8* Dest, int32 Width)
+{
+	int32 X = 0;
+	for (; X + 4 <= Width; X += 4) {
+		// vld2 deinterleaves even and odd pixels for free.
+		uint32x4x2_t Pixels0 = vld2q_u32((const uint32*)(Row0 + X * 8));
+		uint32x4x2_t Pixels1 = vld2q_u32((const uint32*)(Row1 + X * 8));
+		uint8x16_t Even0 = vreinterpretq_u8_u32(Pixels0.val[0]), Odd0 = vreinterpretq_u8_u32(Pixels0.val[1]);
+		uint8x16_t Even1 = vreinterpretq_u8_u32(Pixels1.val[0]), Odd1 = vreinterpretq_u8_u32(Pixels1.val[1]);
+
+		uint16x8_t Low = vaddq_u16(
+			vaddl_u8(vget_low_u8(Even0), vget_low_u8(Odd0)),
+			vaddl_u8(vget_low_u8(Even1), vget_low_u8(Odd1)));
+		uint16x8_t High = vaddq_u16(
+			vaddl_u8(vget_high_u8(Even0), vget_high_u8(Odd0)),
+			vaddl_u8(vget_high_u8(Even1), vget_high_u8(Odd1)));
+
+		vst1q_u8(Dest + X * 4, vcombine_u8(vrshrn_n_u16(Low, 2), vrshrn_n_u16(High, 2)));
+	}
+	DownsampleRowScalar(Row0 + X * 8, Row1 + X * 8, Dest + X * 4, Width - X);
+}
+#endif
+
+// Palette expansion writes Width pixels from 8-bit indices. Palettes of up to 16 colours take the shuffle path where a
+// byte shuffle per channel plane stands in for the lookup, bigger ones use a gather where the CPU has one.
+typedef void (*ExpandRowFunc)(const uint8* Source, const PixelPalette* Palette, uint8* Dest, int32 Width);
+
+static void ExpandRowScalar(const uint8* Source, const PixelPalette* Palette, uint8* Dest, int32 Width)
+{
+	const uint32* Colors = Palette->Colors;
+	uint32* DestPixels = (uint32*)Dest;
+	for (int32 X = 0; X < Width; X++) {
+		DestPixels[X] = Colors[Source[X]];
+	}
+}
+
+#if PIXEL_CONVERT_X86
+PIXEL_CONVERT_TARGET("ssse3")
+static void ExpandRowSSSE3(const uint8* Source, const PixelPalette* Palette, uint8* Dest, int32 Width)
+{
+	int32 X = 0;
+	if (Palette->Count <= 16) {
+		const __m128i Plane0 = _mm_loadu_si128((const __m128i*)Palette->Planes[0]);
+		const __m128i Plane1 = _mm_loadu_si128((const __m128i*)Palette->Planes[1]);
+		const __m128i Plane2 = _mm_loadu_si128((const __m128i*)Palette->Planes[2]);
+		const __m128i Plane3 = _mm_loadu_si128((const __m128i*)Palette->Planes[3]);
+
+		for (; X + 16 <= Width; X += 16) {
+			__m128i Indices = _mm_loadu_si128((const __m128i*)(Source + X));
+			__m128i Byte0 = _mm_shuffle_epi8(Plane0, Indices);
+			__m128i Byte1 = _mm_shuffle_epi8(Plane1, Indices);
+			__m128i Byte2 = _mm_shuffle_epi8(Plane2, Indices);
+			__m128i Byte3 = _mm_shuffle_epi8(Plane3, Indices);
+
+			// Interleave the planes back into pixels, 01 and 23 byte pairs first then the pairs into whole pixels.
+			__m128i Low01 = _mm_unpacklo_epi8(Byte0, Byte1), High01 = _mm_unpackhi_epi8(Byte0, Byte1);
+			__m128i Low23 = _mm_unpacklo_epi8(Byte2, Byte3), High23 = _mm_unpackhi_epi8(Byte2, Byte3);
+			_mm_storeu_si128((__m128i*)(Dest + X * 4), _mm_unpacklo_epi16(Low01, Low23));
+			_mm_storeu_si128((__m128i*)(Dest + X * 4 + 16), _mm_unpackhi_epi16(Low01, Low23));
+			_mm_storeu_si128((__m128i*)(Dest + X * 4 + 32), _mm_unpacklo_epi16(High01, High23));
+			_mm_storeu_si128((__m128i*)(Dest + X * 4 + 48), _mm_unpackhi_epi16(High01, High23));
+		}
+	}
+	ExpandRowScalar(Source + X, Palette, Dest + X * 4, Width - X);
+}
+
+PIXEL_CONVERT_TARGET("avx2")
+static void ExpandRowAVX2(const uint8* Source, const PixelPalette* Palette, uint8* Dest, int32 Width)
+{
+	// Gathers are slow enough that four shuffles per 16 pixels still win for small palettes.
+	if (Palette->Count <= 16) {
+		ExpandRowSSSE3(Source, Palette, Dest, Width);
+		return;
+	}
+
+	const int* Colors = (const int*)Palette->Colors;
+	int32 X = 0;
+	for (; X + 8 <= Width; X += 8) {
+		__m256i Indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(Source + X)));
+		_mm256_storeu_si256((__m256i*)(Dest + X * 4), _mm256_i32gather_epi32(Colors, Indices, 4));
+	}
+	ExpandRowScalar(Source + X, Palette, Dest + X * 4, Width - X);
+}
+#endif
+
+#if PIXEL_CONVERT_NEON
+static void ExpandRowNEON(const uint8* Source, const PixelPalette* Palette, uint8* Dest, int32 Width)
+{
+	int32 X = 0;
+	if (Palette->Count <= 16) {
+		const uint8x16_t Plane0 = vld1q_u8(Palette->Planes[0]);
+		const uint8x16_t Plane1 = vld1q_u8(Palette->Planes[1]);
+		const uint8x16_t Plane2 = vld1q_u8(Palette->Planes[2]);
+		const uint8x16_t Plane3 = vld1q_u8(Palette->Planes[3]);
+
+		for (; X + 16 <= Width; X += 16) {
+			uint8x16_t Indices = vld1q_u8(Source + X);
+			// vst4 interleaves the four planes back into pixels on the way out.
+			uint8x16x4_t Pixels = {{
+				vqtbl1q_u8(Plane0, Indices),
+				vqtbl1q_u8(Plane1, Indices),
+				vqtbl1q_u8(Plane2, Indices),
+				vqtbl1q_u8(Plane3, Indices),
+			}};
+			vst4q_u8(Dest + X * 4, Pixels);
+		}
+	}
+	ExpandRowScalar(Source + X, Palette, Dest + X * 4, Width - X);
+}
+#endif
+
+static void ConvertRowRGB565(const uint8* Source, uint8* Dest, int32 Width)
+{
+	for (int32 X = 0; X < Width; X++, Source += 2, Dest += 4) {
+		uint16 Pixel = (uint16)(Source[0] | (Source[1] << 8));
+		uint8 R = (Pixel >> 11) & 0x1F;
+		uint8 G = (Pixel >> 5) & 0x3F;
+		uint8 B = Pixel & 0x1F;
+		Dest[0] = (uint8)((R << 3) | (R >> 2));
+		Dest[1] = (uint8)((G << 2) | (G >> 4));
+		Dest[2] = (uint8)((B << 3) | (B >> 2));
+		Dest[3] = 0xFF;
+	}
+}
+
+// One instruction set's row functions, swapped in as a whole so a conversion never mixes kernels.
+typedef struct PixelKernels {
+	PixelConvertKernel Kernel;
+	SwizzleRowFunc SwizzleRow;
+	DownsampleRowFunc DownsampleRow;
+	ExpandRowFunc ExpandRow;
+} PixelKernels;
+
+static const PixelKernels KernelTable[PixelConvertKernel_Count] = {
+	[PixelConvertKernel_Scalar] = {PixelConvertKernel_Scalar, SwizzleRowScalar, DownsampleRowScalar, ExpandRowScalar},
+#if PIXEL_CONVERT_X86
+	[PixelConvertKernel_SSSE3] = {PixelConvertKernel_SSSE3, SwizzleRowSSSE3, DownsampleRowSSE2, ExpandRowSSSE3},
+	[PixelConvertKernel_AVX2] = {PixelConvertKernel_AVX2, SwizzleRowAVX2, DownsampleRowAVX2, ExpandRowAVX2},
+#endif
+#if PIXEL_CONVERT_NEON
+	[PixelConvertKernel_NEON] = {PixelConvertKernel_NEON, SwizzleRowNEON, DownsampleRowNEON, ExpandRowNEON},
+#endif
+};
+
+// Points into KernelTable, NULL until the first conversion or PixelConvertSetKernel. Capture and decode jobs can run
+// their first conversion at the same time, so it's only ever read and published atomically.
+static void* GPixelKernels;
+
+static const char* KernelNames[] = {"Auto", "Scalar", "SSSE3", "AVX2", "NEON"};
+_Static_assert(ARRAY_COUNT(KernelNames) == PixelConvertKernel_Count, "");
+
+#if PIXEL_CONVERT_X86
+// SDL has no SSSE3 query, SDL_HasSSE3 is the older SSE3 and SDL_HasSSE41 would leave out CPUs that stop at SSSE3
+// (Core 2 Merom, early Atom). CPUID leaf 1 reports it in ECX bit 9.
+static bool HasSSSE3(void)
+{
+#if defined(_MSC_VER)
+	int Registers[4];
+	__cpuid(Registers, 1);
+	return (Registers[2] & (1 << 9)) != 0;
+#else
+	return __builtin_cpu_supports("ssse3");
+#endif
+}
+#endif
+
+static bool IsKernelSupported(PixelConvertKernel Kernel)
+{
+	switch (Kernel) {
+		case PixelConvertKernel_Scalar: return true;
+#if PIXEL_CONVERT_X86
+		case PixelConvertKernel_SSSE3: return HasSSSE3();
+		case PixelConvertKernel_AVX2: return SDL_HasAVX2();
+#endif
+#if PIXEL_CONVERT_NEON
+		case PixelConvertKernel_NEON: return SDL_HasNEON();
+#endif
+		default: return false;
+	}
+}
+
+static PixelConvertKernel SelectKernel(PixelConvertKernel Kernel)
+{
+	if (Kernel == PixelConvertKernel_Auto) {
+		static const PixelConvertKernel Preferred[] = {
+			PixelConvertKernel_AVX2,
+			PixelConvertKernel_SSSE3,
+			PixelConvertKernel_NEON,
+		};
+		for (int32 Index = 0; Index < ARRAY_COUNT(Preferred); Index++) {
+			if (IsKernelSupported(Preferred[Index])) {
+				return Preferred[Index];
+			}
+		}
+		return PixelConvertKernel_Scalar;
+	}
+	return IsKernelSupported(Kernel) ? Kernel : PixelConvertKernel_Scalar;
+}
+
+static const PixelKernels* GetKernels(void)
+{
+	const PixelKernels* Kernels = SDL_GetAtomicPointer(&GPixelKernels);
+	if (Kernels == NULL) {
+		// Racing first conversions all select the same table, whichever publishes first wins.
+		const PixelKernels* Selected = &KernelTable[SelectKernel(PixelConvertKernel_Auto)];
+		SDL_CompareAndSwapAtomicPointer(&GPixelKernels, NULL, (void*)Selected);
+		Kernels = SDL_GetAtomicPointer(&GPixelKernels);
+	}
+	return Kernels;
+}
+
+PixelConvertKernel PixelConvertSetKernel(PixelConvertKernel Kernel)
+{
+	Kernel = SelectKernel(Kernel);
+	SDL_SetAtomicPointer(&GPixelKernels, (void*)&KernelTable[Kernel]);
+	return Kernel;
+}
+
+PixelConvertKernel PixelConvertGetKernel(void)
+{
+	return GetKernels()->Kernel;
+}
+
+const char* PixelConvertGetKernelName(PixelConvertKernel Kernel)
+{
+	return VALID_INDEX(Kernel, PixelConvertKernel_Count) ? KernelNames[Kernel] : "Invalid";
+}
+
+static bool GetSwizzleDesc(SDL_PixelFormat Format, SwizzleDesc* OutDesc)
+{
+	switch (Format) {
+		case SDL_PIXELFORMAT_ARGB8888: *OutDesc = (SwizzleDesc){{2, 1, 0, 3}, 0x00000000}; return true;
+		case SDL_PIXELFORMAT_XRGB8888: *OutDesc = (SwizzleDesc){{2, 1, 0, 3}, 0xFF000000}; return true;
+		case SDL_PIXELFORMAT_BGRX8888: *OutDesc = (SwizzleDesc){{1, 2, 3, 0}, 0xFF000000}; return true;
+		case SDL_PIXELFORMAT_XBGR8888: *OutDesc = (SwizzleDesc){{0, 1, 2, 3}, 0xFF000000}; return true;
+		case SDL_PIXELFORMAT_ABGR8888: *OutDesc = (SwizzleDesc){{0, 1, 2, 3}, 0x00000000}; return true;
+		default: return false;
+	}
+}
+
+bool PixelConvertIsSupported(SDL_PixelFormat SourceFormat)
+{
+	SwizzleDesc Desc;
+	return SourceFormat == SDL_PIXELFORMAT_RGB565 || GetSwizzleDesc(SourceFormat, &Desc);
+}
+
+bool ConvertPixelsToRGBA32(
+	const void* Source,
+	int32 SourcePitch,
+	SDL_PixelFormat SourceFormat,
+	void* Dest,
+	int32 DestPitch,
+	int32 Width,
+	int32 Height,
+	uint32 Flags)
+{
+	ASSERT(Source && Dest);
+
+	// Flipping is folded into the source walk so each source row is read exactly once.
+	const uint8* SourceRow = (const uint8*)Source;
+	int32 SourceStep = SourcePitch;
+	if ((Flags & PixelConvertFlags_FlipVertical) != 0) {
+		SourceRow += (ptrdiff_t)(Height - 1) * SourcePitch;
+		SourceStep = -SourcePitch;
+	}
+	uint8* DestRow = (uint8*)Dest;
+
+	if (SourceFormat == SDL_PIXELFORMAT_RGB565) {
+		for (int32 Y = 0; Y < Height; Y++, SourceRow += SourceStep, DestRow += DestPitch) {
+			ConvertRowRGB565(SourceRow, DestRow, Width);
+		}
+		return true;
+	}
+
+	SwizzleDesc Desc;
+	if (!GetSwizzleDesc(SourceFormat, &Desc)) {
+		return false;
+	}
+
+	SwizzleRowFunc SwizzleRow = GetKernels()->SwizzleRow;
+	for (int32 Y = 0; Y < Height; Y++, SourceRow += SourceStep, DestRow += DestPitch) {
+		SwizzleRow(SourceRow, DestRow, Width, &Desc);
+	}
+	return true;
+}
+
+void DownsamplePixels2x2(
+	const void* Source,
+	int32 SourcePitch,
+	void* Dest,
+	int32 DestPitch,
+	int32 DestWidth,
+	int32 DestHeight)
+{
+	ASSERT(Source && Dest);
+
+	DownsampleRowFunc DownsampleRow = GetKernels()->DownsampleRow;
+	const uint8* SourceRow = (const uint8*)Source;
+	uint8* DestRow = (uint8*)Dest;
+	for (int32 Y = 0; Y < DestHeight; Y++, SourceRow += 2 * (ptrdiff_t)SourcePitch, DestRow += DestPitch) {
+		DownsampleRow(SourceRow, SourceRow + SourcePitch, DestRow, DestWidth);
+	}
+}
+
+void PixelPaletteInitialize(PixelPalette* Palette, const uint32* Colors, int32 Count)
+{
+	ASSERT(Count >= 0 && Count <= 256);
+
+	SDL_zerop(Palette);
+	Palette->Colors = Colors;
+	Palette->Count = Count;
+	for (int32 Index = 0; Index < SDL_min(Count, 16); Index++) {
+		const uint8* Bytes = (const uint8*)&Colors[Index];
+		for (int32 Plane = 0; Plane < 4; Plane++) {
+			Palette->Planes[Plane][Index] = Bytes[Plane];
+		}
+	}
+}
+
+int32 IndexPixels(
+	const void* Source,
+	int32 SourcePitch,
+	int32 Width,
+	int32 Height,
+	uint8* OutIndices,
+	uint32* OutColors)
+{
+	ASSERT(Source && OutIndices && OutColors);
+
+	int32 Count = 0;
+	int32 LastIndex = -1;
+	const uint8* SourceRow = (const uint8*)Source;
+	for (int32 Y = 0; Y < Height; Y++, SourceRow += SourcePitch) {
+		const uint32* Pixels = (const uint32*)SourceRow;
+		for (int32 X = 0; X < Width; X++) {
+			// Patterns are mostly runs of the same colour so the previous hit is checked before searching.
+			int32 Index = (LastIndex >= 0 && OutColors[LastIndex] == Pixels[X]) ? LastIndex : -1;
+			for (int32 Candidate = 0; Index < 0 && Candidate < Count; Candidate++) {
+				Index = (OutColors[Candidate] == Pixels[X]) ? Candidate : -1;
+			}
+			if (Index < 0) {
+				if (Count == 256) {
+					return -1;
+				}
+				Index = Count++;
+				OutColors[Index] = Pixels[X];
+			}
+
+			OutIndices[Y * Width + X] = (uint8)Index;
+			LastIndex = Index;
+		}
+	}
+	return Count;
+}
+
+void ExpandIndexedPixels(const uint8* Source, const PixelPalette* Palette, void* Dest, int32 Width)
+{
+	ASSERT(Source && Palette && Dest);
+
+	GetKernels()->ExpandRow(Source, Palette, (uint8*)Dest, Width);
+}
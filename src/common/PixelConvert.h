@@ -0,0 +1,80 @@
+#pragma once
+
+#include <SDL3/SDL_pixels.h>
+
+#include "Types.h"
+
+// Converts the pixel layouts desktop capture backends hand us into SDL_PIXELFORMAT_RGBA32 in a single pass, optionally
+// flipping rows on the way (e.g. bottom-up Windows DIBs), box filters them down for scaled outputs and expands palette
+// indexed images. Kernels are picked at runtime from the best instruction set the CPU supports.
+
+typedef enum PixelConvertFlags {
+	PixelConvertFlags_None = 0,
+	PixelConvertFlags_FlipVertical = 1 << 0,
+} PixelConvertFlags;
+
+typedef enum PixelConvertKernel {
+	PixelConvertKernel_Auto,
+	PixelConvertKernel_Scalar,
+	PixelConvertKernel_SSSE3,
+	PixelConvertKernel_AVX2,
+	PixelConvertKernel_NEON,
+	PixelConvertKernel_Count,
+} PixelConvertKernel;
+
+// Supported sources (little endian byte order in brackets):
+//   SDL_PIXELFORMAT_ARGB8888 [B G R A], SDL_PIXELFORMAT_XRGB8888 [B G R x], SDL_PIXELFORMAT_BGRX8888 [x R G B],
+//   SDL_PIXELFORMAT_XBGR8888 [R G B x], SDL_PIXELFORMAT_ABGR8888 [R G B A] and SDL_PIXELFORMAT_RGB565.
+// Formats with an x channel produce opaque alpha.
+bool PixelConvertIsSupported(SDL_PixelFormat SourceFormat);
+
+bool ConvertPixelsToRGBA32(
+	const void* Source,
+	int32 SourcePitch,
+	SDL_PixelFormat SourceFormat,
+	void* Dest,
+	int32 DestPitch,
+	int32 Width,
+	int32 Height,
+	uint32 Flags);
+
+// Halves a 4 byte per pixel image in both dimensions with a 2x2 box filter, every channel is averaged independently so
+// the pixel layout doesn't matter. Source must hold at least DestWidth * 2 by DestHeight * 2 pixels, odd trailing
+// columns and rows are left out.
+void DownsamplePixels2x2(
+	const void* Source,
+	int32 SourcePitch,
+	void* Dest,
+	int32 DestPitch,
+	int32 DestWidth,
+	int32 DestHeight);
+
+// Palette for ExpandIndexedPixels. Colors points at Count (at most 256) 4 byte pixels owned by the caller, Planes holds
+// the first 16 split into one table per byte for the shuffle kernels. Build it with PixelPaletteInitialize.
+typedef struct PixelPalette {
+	const uint32* Colors;
+	int32 Count;
+	uint8 Planes[4][16];
+} PixelPalette;
+
+void PixelPaletteInitialize(PixelPalette* Palette, const uint32* Colors, int32 Count);
+
+// Builds an 8-bit indexed copy of a 4 byte per pixel image, OutIndices gets Width * Height tightly packed indices and
+// OutColors (room for 256) the distinct pixel values in order of first appearance. Returns the number of colours, or
+// -1 when there are more than 256 and the image can't be indexed.
+int32 IndexPixels(
+	const void* Source,
+	int32 SourcePitch,
+	int32 Width,
+	int32 Height,
+	uint8* OutIndices,
+	uint32* OutColors);
+
+// Dest[X] = Palette->Colors[Source[X]] for Width pixels. Every index must be below Palette->Count.
+void ExpandIndexedPixels(const uint8* Source, const PixelPalette* Palette, void* Dest, int32 Width);
+
+// Overrides runtime kernel selection, unsupported kernels fall back to scalar. Returns the kernel actually selected.
+// Safe while conversions run on other threads, each conversion keeps the kernel it started with.
+PixelConvertKernel PixelConvertSetKernel(PixelConvertKernel Kernel);
+PixelConvertKernel PixelConvertGetKernel(void);
+const char* PixelConvertGetKernelName(PixelConvertKernel Kernel);
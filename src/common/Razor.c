@@ -3,16 +3,14 @@
 #include <SDL3/SDL.h>
 struct {
 	Application* App;
-	RazorConfig* Config;
 } GRazor;
 
 const char* RazorBehaviorNames[RazorBehavior_Count] =
 	{"Idle", "Reposition", "WaitToShave", "Shave", "WaitToReposition", "Done,"};
 
-void InitializeRazors(Application* App, RazorConfig* Config)
+void InitializeRazors(Application* App)
 {
 	GRazor.App = App;
-	GRazor.Config = Config;
 }
 
 const char* GetRazorBehaviorName(RazorBehavior Behavior)
@@ -21,6 +19,14 @@ const char* GetRazorBehaviorName(RazorBehavior Behavior)
 	return RazorBehaviorNames[Behavior];
 }
 
+void RazorSetLane(RazorState* Razor, const RazorConfig* Config, int32 LaneStart, int32 LaneEnd)
+{
+	ASSERT(LaneStart < LaneEnd);
+	Razor->Config = Config;
+	Razor->LaneStart = LaneStart;
+	Razor->LaneEnd = LaneEnd;
+}
+
 void RazorSetPosition(RazorState* Razor, Vec2 Position)
 {
 	Razor->Position = Position;
@@ -33,7 +39,7 @@ void RazorWait(RazorState* Razor, float32 Duration, InterpolatorOnFinish OnFinis
 	Razor->StartPosition = Razor->Position;
 	Razor->TargetPosition = Razor->Position;
 	Razor->InterpolatorId =
-		CreateInterpolator(GRazor.Config->InterpolatorContext, InterpFuncLinear, 0.0f, 1.0f, Duration, OnFinish, Razor);
+		CreateInterpolator(Razor->Config->InterpolatorContext, InterpFuncLinear, 0.0f, 1.0f, Duration, OnFinish, Razor);
 }
 
 void RazorMoveTo(RazorState* Razor, Vec2 TargetPosition, float32 Duration, InterpolatorOnFinish OnFinish)
@@ -41,7 +47,7 @@ void RazorMoveTo(RazorState* Razor, Vec2 TargetPosition, float32 Duration, Inter
 	Razor->StartPosition = Razor->Position;
 	Razor->TargetPosition = TargetPosition;
 	Razor->InterpolatorId =
-		CreateInterpolator(GRazor.Config->InterpolatorContext, InterpFuncLinear, 0.0f, 1.0f, Duration, OnFinish, Razor);
+		CreateInterpolator(Razor->Config->InterpolatorContext, InterpFuncLinear, 0.0f, 1.0f, Duration, OnFinish, Razor);
 }
 
 void RazorEaseTo(RazorState* Razor, Vec2 TargetPosition, float32 Duration, InterpolatorOnFinish OnFinish)
@@ -49,7 +55,7 @@ void RazorEaseTo(RazorState* Razor, Vec2 TargetPosition, float32 Duration, Inter
 	Razor->StartPosition = Razor->Position;
 	Razor->TargetPosition = TargetPosition;
 	Razor->InterpolatorId = CreateInterpolator(
-		GRazor.Config->InterpolatorContext,
+		Razor->Config->InterpolatorContext,
 		InterpFuncEaseInOutQuad,
 		0.0f,
 		1.0f,
@@ -69,14 +75,24 @@ SDL_Rect PositionToRazorShaveBounds(const RazorConfig* Razor, Vec2 Position)
 	};
 }
 
-Vec2 GetRazorCenterDisplayPosition(const Display* RazorDisplay, const RazorConfig* Razor)
+Vec2 GetRazorCenterLanePosition(const Display* RazorDisplay, const RazorState* Razor)
 {
-	return V2(RazorDisplay->Width / 2 - Razor->Image->w / 2, RazorDisplay->Height / 2 - Razor->Image->h / 2);
+	int32 LaneCenter = (Razor->LaneStart + Razor->LaneEnd) / 2;
+	const SDL_Surface* Image = Razor->Config->Image;
+	int32 Width = Image ? Image->w : 0;
+	int32 Height = Image ? Image->h : 0;
+	return V2(LaneCenter - Width / 2, RazorDisplay->Height / 2 - Height / 2);
+}
+
+// Razor position that puts the blade's left edge on the first column of stroke ShaveIndex.
+static float32 RazorStrokeX(const RazorState* Razor, int32 ShaveIndex)
+{
+	return Razor->LaneStart + ShaveIndex * Razor->Config->BladeBounds.w - Razor->Config->BladeBounds.x;
 }
 
 float32 RazorEvaluatePosition(RazorState* Razor)
 {
-	float32 Value = EvalInterpolator(GRazor.Config->InterpolatorContext, Razor->InterpolatorId);
+	float32 Value = EvalInterpolator(Razor->Config->InterpolatorContext, Razor->InterpolatorId);
 	Razor->LastPosition = Razor->Position;
 	Razor->Position = Lerp(Razor->StartPosition, Razor->TargetPosition, Value);
 	return Value;
@@ -98,8 +114,9 @@ void RazorMoveFinished(InterpolatorContext* Context, InterpolatorHandle Interp,
 	switch (Razor->Behavior) {
 		case RazorBehavior_Idle:
 			Razor->ShaveIndex = 0;
+			ShaveCoverageReset(&RazorDisplay->Coverage, Razor->LaneStart, Razor->LaneEnd);
 			Razor->Behavior = RazorBehavior_Reposition;
-			RazorEaseTo(Razor, V2(0, 0), IdleDuration, RazorMoveFinished);
+			RazorEaseTo(Razor, V2(RazorStrokeX(Razor, 0), 0), IdleDuration, RazorMoveFinished);
 			break;
 
 		case RazorBehavior_Reposition:
@@ -113,24 +130,36 @@ void RazorMoveFinished(InterpolatorContext* Context, InterpolatorHandle Interp,
 			break;
 
 		case RazorBehavior_Shave:
+			// The frame update only fills razors that are still shaving, the last stretch down to the bottom row has
+			// to be filled here.
+			Razor->Position = Razor->TargetPosition;
+			FillRazorLane(GRazor.App, Razor);
 			Razor->Behavior = RazorBehavior_WaitToReposition;
 			RazorWait(Razor, WaitToRepositionDuration, RazorMoveFinished);
 			break;
 
 		case RazorBehavior_WaitToReposition:
-			Razor->ShaveIndex++;
-			float32 NextX = Razor->ShaveIndex * GRazor.Config->BladeBounds.w;
-
-			if (NextX < RazorDisplay->Width) {
+			int32 NextColumn =
+				ShaveCoverageNextUncoveredColumn(&RazorDisplay->Coverage, Razor->LaneStart, Razor->LaneEnd);
+
+			// Snap to the blade grid so strokes stay aligned. The index only moves forward, a stroke that left its
+			// columns uncovered (no pattern decoded yet) isn't retried, so a cycle never takes more strokes than the
+			// lane is wide.
+			int32 NextIndex =
+				MAX((NextColumn - Razor->LaneStart) / Razor->Config->BladeBounds.w, Razor->ShaveIndex + 1);
+			if (NextColumn < Razor->LaneEnd &&
+				NextIndex * Razor->Config->BladeBounds.w < Razor->LaneEnd - Razor->LaneStart)
+			{
+				Razor->ShaveIndex = NextIndex;
 				Razor->Behavior = RazorBehavior_Reposition;
-				RazorEaseTo(Razor, V2(NextX, 0), RepositionDuration, RazorMoveFinished);
+				RazorEaseTo(Razor, V2(RazorStrokeX(Razor, NextIndex), 0), RepositionDuration, RazorMoveFinished);
 			} else {
 				Razor->CycleIndex++;
 				Razor->Behavior = RazorBehavior_Idle;
 				RazorWait(Razor, IdleDuration, RazorMoveFinished);
 
 				// Razor->Behavior = RazorBehavior_Done;
-				// RazorEaseTo(Razor, GetRazorCenterDisplayPosition(RazorDisplay, GRazor.Config), 1.0f, RazorMoveFinished);
+				// RazorEaseTo(Razor, GetRazorCenterLanePosition(RazorDisplay, Razor), 1.0f, RazorMoveFinished);
 			}
 			break;
 
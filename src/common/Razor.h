@@ -26,6 +26,7 @@ typedef enum RazorBehavior {
 } RazorBehavior;
 
 typedef struct RazorState {
+	const RazorConfig* Config;
 	InterpolatorHandle InterpolatorId;
 	Vec2 StartPosition;
 	Vec2 TargetPosition;
@@ -33,18 +34,22 @@ typedef struct RazorState {
 	Vec2 LastPosition;
 	int32 Behavior;
 	int32 CycleIndex;
+	int32 PatternIndex; // Latched from CycleIndex while idling, patterns added mid cycle don't change it
 	int32 ShaveIndex;
+	int32 LaneStart; // First display column this razor is allowed to shave
+	int32 LaneEnd;	 // One past the last display column this razor is allowed to shave
 } RazorState;
 
 
-void InitializeRazors(Application *App, RazorConfig *Config);
+void InitializeRazors(Application *App);
 const char *GetRazorBehaviorName(RazorBehavior Behavior);
 
+void RazorSetLane(RazorState* Razor, const RazorConfig* Config, int32 LaneStart, int32 LaneEnd);
 void RazorSetPosition(RazorState* Razor, Vec2 Position);
 void RazorWait(RazorState* Razor, float32 Duration, InterpolatorOnFinish OnFinish);
 void RazorMoveTo(RazorState* Razor, Vec2 TargetPosition, float32 Duration, InterpolatorOnFinish OnFinish);
 void RazorEaseTo(RazorState* Razor, Vec2 TargetPosition, float32 Duration, InterpolatorOnFinish OnFinish);
 SDL_Rect PositionToRazorShaveBounds(const RazorConfig* Razor, Vec2 Position);
-Vec2 GetRazorCenterDisplayPosition(const Display *Disp, const RazorConfig* Razor);
+Vec2 GetRazorCenterLanePosition(const Display *Disp, const RazorState* Razor);
 float32 RazorEvaluatePosition(RazorState* Razor);
 void RazorMoveFinished(InterpolatorContext* Context, InterpolatorHandle Interp, void* UserData);
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include "ResourceCache.h"
+
+#include <SDL3/SDL.h>
+#include <stb_ds.h>
+
+#include "Log.h"
+
+typedef struct CachedSurface {
+	char* AssetId;
+	SDL_Surface* Surface;
+	int64 Bytes;
+	int32 RefCount;
+	uint64 LastReleased; // Release clock when the last reference went away
+} CachedSurface;
+
+typedef struct CachedTexture {
+	char* AssetId;
+	SDL_Renderer* Renderer;
+	SDL_Texture* Texture;
+	int64 Bytes;
+	int32 RefCount;
+	uint64 LastReleased;
+} CachedTexture;
+
+static struct {
+	SDL_Mutex* SurfaceMutex; // Guards everything surface related, textures never leave the main thread
+	CachedSurface* Surfaces;
+	int64 SurfaceBudget;
+	int64 SurfaceBytes;
+	uint64 SurfaceClock;
+	CachedTexture* Textures;
+	int64 TextureBudget;
+	int64 TextureBytes;
+	uint64 TextureClock;
+} GResourceCache;
+
+static CachedSurface* FindSurface(const char* AssetId)
+{
+	for (int32 Index = 0; Index < arrlen(GResourceCache.Surfaces); Index++) {
+		if (SDL_strcmp(GResourceCache.Surfaces[Index].AssetId, AssetId) == 0) {
+			return &GResourceCache.Surfaces[Index];
+		}
+	}
+	return NULL;
+}
+
+static CachedTexture* FindTexture(SDL_Renderer* Renderer, const char* AssetId)
+{
+	for (int32 Index = 0; Index < arrlen(GResourceCache.Textures); Index++) {
+		CachedTexture* Cached = &GResourceCache.Textures[Index];
+		if (Cached->Renderer == Renderer && SDL_strcmp(Cached->AssetId, AssetId) == 0) {
+			return Cached;
+		}
+	}
+	return NULL;
+}
+
+static void EvictSurfaces(void)
+{
+	while (GResourceCache.SurfaceBytes > GResourceCache.SurfaceBudget) {
+		int32 Oldest = -1;
+		for (int32 Index = 0; Index < arrlen(GResourceCache.Surfaces); Index++) {
+			const CachedSurface* Cached = &GResourceCache.Surfaces[Index];
+			if (Cached->RefCount == 0 &&
+				(Oldest < 0 || Cached->LastReleased < GResourceCache.Surfaces[Oldest].LastReleased))
+			{
+				Oldest = Index;
+			}
+		}
+		if (Oldest < 0) {
+			break;
+		}
+
+		CachedSurface* Cached = &GResourceCache.Surfaces[Oldest];
+		LogVerbose("Resources: Evicting surface %s", Cached->AssetId);
+		GResourceCache.SurfaceBytes -= Cached->Bytes;
+		SDL_DestroySurface(Cached->Surface);
+		SDL_free(Cached->AssetId);
+		arrdelswap(GResourceCache.Surfaces, Oldest);
+	}
+}
+
+static void EvictTextures(void)
+{
+	while (GResourceCache.TextureBytes > GResourceCache.TextureBudget) {
+		int32 Oldest = -1;
+		for (int32 Index = 0; Index < arrlen(GResourceCache.Textures); Index++) {
+			const CachedTexture* Cached = &GResourceCache.Textures[Index];
+			if (Cached->RefCount == 0 &&
+				(Oldest < 0 || Cached->LastReleased < GResourceCache.Textures[Oldest].LastReleased))
+			{
+				Oldest = Index;
+			}
+		}
+		if (Oldest < 0) {
+			break;
+		}
+
+		CachedTexture* Cached = &GResourceCache.Textures[Oldest];
+		LogVerbose("Resources: Evicting texture %s", Cached->AssetId);
+		GResourceCache.TextureBytes -= Cached->Bytes;
+		SDL_DestroyTexture(Cached->Texture);
+		SDL_free(Cached->AssetId);
+		arrdelswap(GResourceCache.Textures, Oldest);
+	}
+}
+
+void ResourceCacheInitialize(int64 SurfaceBudget, int64 TextureBudget)
+{
+	SDL_zero(GResourceCache);
+	GResourceCache.SurfaceMutex = SDL_CreateMutex();
+	GResourceCache.SurfaceBudget = SurfaceBudget;
+	GResourceCache.TextureBudget = TextureBudget;
+}
+
+void ResourceCacheShutdown(void)
+{
+	for (int32 Index = 0; Index < arrlen(GResourceCache.Textures); Index++) {
+		CachedTexture* Cached = &GResourceCache.Textures[Index];
+		if (Cached->RefCount > 0) {
+			LogWarning("Resources: Texture %s still has %d reference(s)", Cached->AssetId, Cached->RefCount);
+		}
+		SDL_DestroyTexture(Cached->Texture);
+		SDL_free(Cached->AssetId);
+	}
+	for (int32 Index = 0; Index < arrlen(GResourceCache.Surfaces); Index++) {
+		CachedSurface* Cached = &GResourceCache.Surfaces[Index];
+		if (Cached->RefCount > 0) {
+			LogWarning("Resources: Surface %s still has %d reference(s)", Cached->AssetId, Cached->RefCount);
+		}
+		SDL_DestroySurface(Cached->Surface);
+		SDL_free(Cached->AssetId);
+	}
+
+	arrfree(GResourceCache.Textures);
+	arrfree(GResourceCache.Surfaces);
+	SDL_DestroyMutex(GResourceCache.SurfaceMutex);
+	SDL_zero(GResourceCache);
+}
+
+void ResourceCacheSetBudget(int64 SurfaceBudget, int64 TextureBudget)
+{
+	SDL_LockMutex(GResourceCache.SurfaceMutex);
+	GResourceCache.SurfaceBudget = SurfaceBudget;
+	EvictSurfaces();
+	SDL_UnlockMutex(GResourceCache.SurfaceMutex);
+
+	GResourceCache.TextureBudget = TextureBudget;
+	EvictTextures();
+
+	LogInfo(
+		"Resources: Budget %" SDL_PRIs64 " KB surfaces, %" SDL_PRIs64 " KB textures",
+		SurfaceBudget / 1024,
+		TextureBudget / 1024);
+}
+
+SDL_Surface* ResourceCacheAcquireSurface(const char* AssetId)
+{
+	SDL_LockMutex(GResourceCache.SurfaceMutex);
+	CachedSurface* Cached = FindSurface(AssetId);
+	SDL_Surface* Surface = NULL;
+	if (Cached != NULL) {
+		Cached->RefCount++;
+		Surface = Cached->Surface;
+	}
+	SDL_UnlockMutex(GResourceCache.SurfaceMutex);
+	return Surface;
+}
+
+SDL_Surface* ResourceCacheAddSurface(const char* AssetId, SDL_Surface* Surface)
+{
+	if (Surface == NULL) {
+		return NULL;
+	}
+
+	SDL_LockMutex(GResourceCache.SurfaceMutex);
+	CachedSurface* Cached = FindSurface(AssetId);
+	if (Cached != NULL) {
+		SDL_DestroySurface(Surface);
+		Cached->RefCount++;
+		Surface = Cached->Surface;
+	} else {
+		CachedSurface NewSurface = {
+			.AssetId = SDL_strdup(AssetId),
+			.Surface = Surface,
+			.Bytes = (int64)Surface->pitch * Surface->h,
+			.RefCount = 1,
+		};
+		arrput(GResourceCache.Surfaces, NewSurface);
+		GResourceCache.SurfaceBytes += NewSurface.Bytes;
+		EvictSurfaces();
+	}
+	SDL_UnlockMutex(GResourceCache.SurfaceMutex);
+	return Surface;
+}
+
+void ResourceCacheReleaseSurface(SDL_Surface* Surface)
+{
+	if (Surface == NULL) {
+		return;
+	}
+
+	SDL_LockMutex(GResourceCache.SurfaceMutex);
+	for (int32 Index = 0; Index < arrlen(GResourceCache.Surfaces); Index++) {
+		CachedSurface* Cached = &GResourceCache.Surfaces[Index];
+		if (Cached->Surface == Surface) {
+			ASSERT(Cached->RefCount > 0);
+			if (--Cached->RefCount == 0) {
+				Cached->LastReleased = ++GResourceCache.SurfaceClock;
+				EvictSurfaces();
+			}
+			break;
+		}
+	}
+	SDL_UnlockMutex(GResourceCache.SurfaceMutex);
+}
+
+static SDL_Texture* AddTexture(SDL_Renderer* Renderer, const char* AssetId, SDL_Texture* Texture)
+{
+	CachedTexture NewTexture = {
+		.AssetId = SDL_strdup(AssetId),
+		.Renderer = Renderer,
+		.Texture = Texture,
+		.Bytes = (int64)Texture->w * Texture->h * SDL_BYTESPERPIXEL(Texture->format),
+		.RefCount = 1,
+	};
+	arrput(GResourceCache.Textures, NewTexture);
+	GResourceCache.TextureBytes += NewTexture.Bytes;
+	EvictTextures();
+	return Texture;
+}
+
+SDL_Texture* ResourceCacheAcquireTexture(SDL_Renderer* Renderer, const char* AssetId)
+{
+	CachedTexture* Cached = FindTexture(Renderer, AssetId);
+	if (Cached != NULL) {
+		Cached->RefCount++;
+		return Cached->Texture;
+	}
+
+	// Held locked through the upload so the surface can't be evicted under it.
+	SDL_LockMutex(GResourceCache.SurfaceMutex);
+	CachedSurface* Surface = FindSurface(AssetId);
+	SDL_Texture* Texture = Surface ? SDL_CreateTextureFromSurface(Renderer, Surface->Surface) : NULL;
+	SDL_UnlockMutex(GResourceCache.SurfaceMutex);
+
+	if (Texture == NULL) {
+		LogError("Resources: Unable to create texture for %s", AssetId);
+		return NULL;
+	}
+	return AddTexture(Renderer, AssetId, Texture);
+}
+
+SDL_Texture* ResourceCacheAddTexture(SDL_Renderer* Renderer, const char* AssetId, SDL_Texture* Texture)
+{
+	if (Texture == NULL) {
+		return NULL;
+	}
+
+	CachedTexture* Cached = FindTexture(Renderer, AssetId);
+	if (Cached != NULL) {
+		SDL_DestroyTexture(Texture);
+		Cached->RefCount++;
+		return Cached->Texture;
+	}
+	return AddTexture(Renderer, AssetId, Texture);
+}
+
+void ResourceCacheReleaseTexture(SDL_Texture* Texture)
+{
+	if (Texture == NULL) {
+		return;
+	}
+
+	for (int32 Index = 0; Index < arrlen(GResourceCache.Textures); Index++) {
+		CachedTexture* Cached = &GResourceCache.Textures[Index];
+		if (Cached->Texture == Texture) {
+			ASSERT(Cached->RefCount > 0);
+			if (--Cached->RefCount == 0) {
+				Cached->LastReleased = ++GResourceCache.TextureClock;
+				EvictTextures();
+			}
+			return;
+		}
+	}
+}
+
+int64 ResourceCacheGetSurfaceBytes(void)
+{
+	SDL_LockMutex(GResourceCache.SurfaceMutex);
+	int64 Bytes = GResourceCache.SurfaceBytes;
+	SDL_UnlockMutex(GResourceCache.SurfaceMutex);
+	return Bytes;
+}
+
+int32 ResourceCacheGetSurfaceCount(void)
+{
+	SDL_LockMutex(GResourceCache.SurfaceMutex);
+	int32 Count = arrlen(GResourceCache.Surfaces);
+	SDL_UnlockMutex(GResourceCache.SurfaceMutex);
+	return Count;
+}
+
+int64 ResourceCacheGetTextureBytes(void)
+{
+	return GResourceCache.TextureBytes;
+}
+
+int32 ResourceCacheGetTextureCount(void)
+{
+	return arrlen(GResourceCache.Textures);
+}
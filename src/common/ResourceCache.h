@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Types.h"
+
+// Images shared by asset id. A CPU surface exists once however many razors or displays use it, a texture once per
+// renderer. Both are refcounted, entries nobody holds stay cached until their memory is needed and are then evicted
+// least recently released first, so the budgets are soft. Surface functions are thread safe (razor configs load on a
+// worker), texture functions are main thread only like the rest of SDL rendering.
+
+typedef struct SDL_Surface SDL_Surface;
+typedef struct SDL_Texture SDL_Texture;
+typedef struct SDL_Renderer SDL_Renderer;
+
+void ResourceCacheInitialize(int64 SurfaceBudget, int64 TextureBudget);
+// Every reference must have been released, anything still held is destroyed with a warning.
+void ResourceCacheShutdown(void);
+void ResourceCacheSetBudget(int64 SurfaceBudget, int64 TextureBudget);
+
+// The cached surface for AssetId with a reference added, NULL when it isn't cached.
+SDL_Surface* ResourceCacheAcquireSurface(const char* AssetId);
+// Caches Surface under AssetId and takes ownership of it, returning it with one reference. If AssetId got cached in
+// the meantime Surface is destroyed and the cached one is returned instead.
+SDL_Surface* ResourceCacheAddSurface(const char* AssetId, SDL_Surface* Surface);
+void ResourceCacheReleaseSurface(SDL_Surface* Surface);
+
+// Renderer's texture for AssetId with a reference added, created from the cached surface on first use. NULL when
+// neither a texture nor a surface is cached for AssetId.
+SDL_Texture* ResourceCacheAcquireTexture(SDL_Renderer* Renderer, const char* AssetId);
+// Tracks a texture created elsewhere (e.g. the screenshot), same ownership rules as ResourceCacheAddSurface.
+SDL_Texture* ResourceCacheAddTexture(SDL_Renderer* Renderer, const char* AssetId, SDL_Texture* Texture);
+void ResourceCacheReleaseTexture(SDL_Texture* Texture);
+
+int64 ResourceCacheGetSurfaceBytes(void);
+int32 ResourceCacheGetSurfaceCount(void);
+int64 ResourceCacheGetTextureBytes(void);
+int32 ResourceCacheGetTextureCount(void);
@@ -0,0 +1,142 @@
+#include "ShaveCoverage.h"
+
+#include <HandmadeMath.h>
+#include <SDL3/SDL.h>
+
+static void ClampColumns(const ShaveCoverage* Coverage, int32* X0, int32* X1)
+{
+	*X0 = SDL_clamp(*X0, 0, Coverage->Width);
+	*X1 = SDL_clamp(*X1, *X0, Coverage->Width);
+}
+
+void ShaveCoverageInitialize(ShaveCoverage* Coverage, int32 Width, int32 Height)
+{
+	ASSERT(Width > 0 && Height > 0);
+
+	ZERO_STRUCT(Coverage);
+	Coverage->Width = Width;
+	Coverage->Height = Height;
+	Coverage->ColumnDepth = SDL_calloc(Width, sizeof(int32));
+	ASSERT(Coverage->ColumnDepth);
+}
+
+void ShaveCoverageShutdown(ShaveCoverage* Coverage)
+{
+	SDL_free(Coverage->ColumnDepth);
+	ZERO_STRUCT(Coverage);
+}
+
+void ShaveCoverageReset(ShaveCoverage* Coverage, int32 X0, int32 X1)
+{
+	ClampColumns(Coverage, &X0, &X1);
+
+	for (int32 X = X0; X < X1; X++) {
+		Coverage->CoveredPixels -= Coverage->ColumnDepth[X];
+		Coverage->ColumnDepth[X] = 0;
+	}
+}
+
+void ShaveCoverageAdd(ShaveCoverage* Coverage, int32 X0, int32 X1, int32 Bottom)
+{
+	ClampColumns(Coverage, &X0, &X1);
+	Bottom = SDL_clamp(Bottom, 0, Coverage->Height);
+
+	int32 Top = Bottom;
+	int32 DirtyX0 = X1, DirtyX1 = X0;
+
+	for (int32 X = X0; X < X1; X++) {
+		int32 Depth = Coverage->ColumnDepth[X];
+		if (Depth < Bottom) {
+			Coverage->CoveredPixels += Bottom - Depth;
+			Coverage->ColumnDepth[X] = Bottom;
+			Top = MIN(Top, Depth);
+			DirtyX0 = MIN(DirtyX0, X);
+			DirtyX1 = X + 1;
+		}
+	}
+
+	if (DirtyX0 < DirtyX1) {
+		SDL_Rect Added = {DirtyX0, Top, DirtyX1 - DirtyX0, Bottom - Top};
+		if (SDL_RectEmpty(&Coverage->Dirty)) {
+			Coverage->Dirty = Added;
+		} else {
+			SDL_GetRectUnion(&Coverage->Dirty, &Added, &Coverage->Dirty);
+		}
+	}
+}
+
+void ShaveCoverageClearDirty(ShaveCoverage* Coverage)
+{
+	Coverage->Dirty = (SDL_Rect){0};
+}
+
+float32 ShaveCoveragePercent(const ShaveCoverage* Coverage)
+{
+	int64 TotalPixels = (int64)Coverage->Width * Coverage->Height;
+	return (TotalPixels > 0) ? (float32)(Coverage->CoveredPixels * 100.0 / TotalPixels) : 0.0f;
+}
+
+int32 ShaveCoverageMinDepth(const ShaveCoverage* Coverage, int32 X0, int32 X1)
+{
+	ClampColumns(Coverage, &X0, &X1);
+
+	int32 Result = Coverage->Height;
+	for (int32 X = X0; X < X1; X++) {
+		Result = MIN(Result, Coverage->ColumnDepth[X]);
+	}
+	return Result;
+}
+
+bool ShaveCoverageIsRangeCovered(const ShaveCoverage* Coverage, int32 X0, int32 X1)
+{
+	return ShaveCoverageNextUncoveredColumn(Coverage, X0, X1) >= X1;
+}
+
+int32 ShaveCoverageNextUncoveredColumn(const ShaveCoverage* Coverage, int32 X0, int32 X1)
+{
+	int32 RequestedX1 = X1;
+	ClampColumns(Coverage, &X0, &X1);
+
+	for (int32 X = X0; X < X1; X++) {
+		if (Coverage->ColumnDepth[X] < Coverage->Height) {
+			return X;
+		}
+	}
+	return RequestedX1;
+}
+
+int32 ShaveCoverageGetSpans(
+	const ShaveCoverage* Coverage,
+	int32 X0,
+	int32 X1,
+	bool Covered,
+	CoverageSpan* OutSpans,
+	int32 MaxSpans)
+{
+	ClampColumns(Coverage, &X0, &X1);
+
+	int32 SpanCount = 0;
+	int32 X = X0;
+	while (X < X1) {
+		while (X < X1 && (Coverage->ColumnDepth[X] >= Coverage->Height) != Covered) {
+			X++;
+		}
+		if (X >= X1) {
+			break;
+		}
+
+		CoverageSpan Span = {.X0 = X, .MinDepth = Coverage->Height};
+		while (X < X1 && (Coverage->ColumnDepth[X] >= Coverage->Height) == Covered) {
+			Span.MinDepth = MIN(Span.MinDepth, Coverage->ColumnDepth[X]);
+			X++;
+		}
+		Span.X1 = X;
+
+		if (SpanCount < MaxSpans) {
+			OutSpans[SpanCount] = Span;
+		}
+		SpanCount++;
+	}
+
+	return SpanCount;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SDL3/SDL_rect.h>
+
+#include "Types.h"
+
+// Tracks how much of a display has been shaved as a per-column depth. Because the razor always shaves top to bottom,
+// a column is fully described by how many rows from the top have been covered, so every update is O(columns touched)
+// and no query ever needs to read pixels.
+typedef struct ShaveCoverage {
+	int32 Width;
+	int32 Height;
+	int32* ColumnDepth; // Rows [0, ColumnDepth[X]) of column X are covered
+	int64 CoveredPixels;
+	SDL_Rect Dirty; // Union of everything newly covered since the last ShaveCoverageClearDirty
+} ShaveCoverage;
+
+typedef struct CoverageSpan {
+	int32 X0, X1;	// Column range [X0, X1)
+	int32 MinDepth; // Shallowest column depth within the span
+} CoverageSpan;
+
+void ShaveCoverageInitialize(ShaveCoverage* Coverage, int32 Width, int32 Height);
+void ShaveCoverageShutdown(ShaveCoverage* Coverage);
+
+// Marks columns [X0, X1) as uncovered again, used when a lane starts a new cycle.
+void ShaveCoverageReset(ShaveCoverage* Coverage, int32 X0, int32 X1);
+// Extends coverage of columns [X0, X1) down to Bottom. Columns already deeper than Bottom are left alone.
+void ShaveCoverageAdd(ShaveCoverage* Coverage, int32 X0, int32 X1, int32 Bottom);
+void ShaveCoverageClearDirty(ShaveCoverage* Coverage);
+
+float32 ShaveCoveragePercent(const ShaveCoverage* Coverage);
+int32 ShaveCoverageMinDepth(const ShaveCoverage* Coverage, int32 X0, int32 X1);
+bool ShaveCoverageIsRangeCovered(const ShaveCoverage* Coverage, int32 X0, int32 X1);
+// Returns the first column in [X0, X1) that is not fully covered, or X1 if there is none.
+int32 ShaveCoverageNextUncoveredColumn(const ShaveCoverage* Coverage, int32 X0, int32 X1);
+
+// Writes runs of columns in [X0, X1) that are either fully covered (Covered = true) or not (Covered = false) into
+// OutSpans. Returns the total number of runs which may be larger than MaxSpans.
+int32 ShaveCoverageGetSpans(
+	const ShaveCoverage* Coverage,
+	int32 X0,
+	int32 X1,
+	bool Covered,
+	CoverageSpan* OutSpans,
+	int32 MaxSpans);
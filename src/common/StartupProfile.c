@@ -0,0 +1,158 @@
+#include "StartupProfile.h"
+
+#include <SDL3/SDL.h>
+#include <sokol_time.h>
+#include <stdio.h>
+
+#include "Log.h"
+
+typedef struct StartupSpan {
+	const char* Name;
+	uint64 StartTicks;
+	uint64 EndTicks;
+	SDL_ThreadID Thread;
+	int32 Depth; // -1 for spans recorded from elsewhere
+} StartupSpan;
+
+typedef struct StartupValue {
+	const char* Name;
+	double Value;
+} StartupValue;
+
+static struct {
+	uint64 LaunchTicks;
+	SDL_ThreadID MainThread;
+	StartupSpan Spans[STARTUP_PROFILE_MAX_SPANS];
+	SDL_AtomicInt SpanCount; // Reserved slots, can run past the capacity, extra spans are dropped
+	int32 OpenSpans[STARTUP_PROFILE_MAX_DEPTH];
+	int32 Depth;
+	StartupValue Values[STARTUP_PROFILE_MAX_VALUES];
+	int32 ValueCount;
+} GStartupProfile;
+
+static StartupSpan* StartupProfileReserve(const char* Name, int32* OutIndex)
+{
+	int32 Index = SDL_AddAtomicInt(&GStartupProfile.SpanCount, 1);
+	*OutIndex = Index;
+	if (Index >= STARTUP_PROFILE_MAX_SPANS) {
+		return NULL;
+	}
+
+	StartupSpan* Span = &GStartupProfile.Spans[Index];
+	Span->Name = Name;
+	Span->Thread = SDL_GetCurrentThreadID();
+	return Span;
+}
+
+void StartupProfileInitialize(uint64 LaunchTicks)
+{
+	SDL_zero(GStartupProfile);
+	GStartupProfile.LaunchTicks = LaunchTicks;
+	GStartupProfile.MainThread = SDL_GetCurrentThreadID();
+}
+
+void StartupProfileBegin(const char* Name)
+{
+	ASSERT(SDL_GetCurrentThreadID() == GStartupProfile.MainThread);
+	ASSERT(GStartupProfile.Depth < STARTUP_PROFILE_MAX_DEPTH);
+
+	int32 Index;
+	StartupSpan* Span = StartupProfileReserve(Name, &Index);
+	if (Span != NULL) {
+		Span->Depth = GStartupProfile.Depth;
+		Span->StartTicks = stm_now();
+	}
+	GStartupProfile.OpenSpans[GStartupProfile.Depth++] = Index;
+}
+
+void StartupProfileEnd(void)
+{
+	ASSERT(GStartupProfile.Depth > 0);
+
+	int32 Index = GStartupProfile.OpenSpans[--GStartupProfile.Depth];
+	if (Index < STARTUP_PROFILE_MAX_SPANS) {
+		GStartupProfile.Spans[Index].EndTicks = stm_now();
+	}
+}
+
+void StartupProfileRecord(const char* Name, uint64 StartTicks, uint64 EndTicks)
+{
+	int32 Index;
+	StartupSpan* Span = StartupProfileReserve(Name, &Index);
+	if (Span != NULL) {
+		Span->Depth = -1;
+		Span->StartTicks = StartTicks;
+		Span->EndTicks = EndTicks;
+	}
+}
+
+void StartupProfileSetValue(const char* Name, double Value)
+{
+	for (int32 Index = 0; Index < GStartupProfile.ValueCount; Index++) {
+		if (SDL_strcmp(GStartupProfile.Values[Index].Name, Name) == 0) {
+			GStartupProfile.Values[Index].Value = Value;
+			return;
+		}
+	}
+
+	if (GStartupProfile.ValueCount < STARTUP_PROFILE_MAX_VALUES) {
+		GStartupProfile.Values[GStartupProfile.ValueCount++] = (StartupValue){Name, Value};
+	}
+}
+
+static double StartupProfileMs(uint64 Ticks)
+{
+	return (Ticks > GStartupProfile.LaunchTicks) ? stm_ms(Ticks - GStartupProfile.LaunchTicks) : 0.0;
+}
+
+bool StartupProfileWriteReport(const char* FileName)
+{
+	ASSERT(GStartupProfile.Depth == 0);
+
+	FILE* File = fopen(FileName, "w");
+	if (File == NULL) {
+		LogError("Startup: Unable to write profile to '%s'", FileName);
+		return false;
+	}
+
+	int32 RecordedCount = SDL_GetAtomicInt(&GStartupProfile.SpanCount);
+	int32 SpanCount = SDL_min(RecordedCount, STARTUP_PROFILE_MAX_SPANS);
+
+	// Names are literals from our own code so they never need escaping.
+	fprintf(File, "{\n");
+	fprintf(File, "\t\"version\": 1,\n");
+	fprintf(File, "\t\"platform\": \"%s\",\n", SDL_GetPlatform());
+	fprintf(File, "\t\"total_ms\": %.3f,\n", stm_ms(stm_since(GStartupProfile.LaunchTicks)));
+	fprintf(File, "\t\"dropped_spans\": %d,\n", RecordedCount - SpanCount);
+
+	fprintf(File, "\t\"values\": {");
+	for (int32 Index = 0; Index < GStartupProfile.ValueCount; Index++) {
+		const StartupValue* Value = &GStartupProfile.Values[Index];
+		fprintf(File, "%s\n\t\t\"%s\": %.3f", (Index > 0) ? "," : "", Value->Name, Value->Value);
+	}
+	fprintf(File, "\n\t},\n");
+
+	fprintf(File, "\t\"spans\": [");
+	for (int32 Index = 0; Index < SpanCount; Index++) {
+		const StartupSpan* Span = &GStartupProfile.Spans[Index];
+		fprintf(
+			File,
+			"%s\n\t\t{\"name\": \"%s\", \"thread\": \"%s\", \"depth\": %d, \"start_ms\": %.3f, \"duration_ms\": %.3f}",
+			(Index > 0) ? "," : "",
+			Span->Name,
+			(Span->Thread == GStartupProfile.MainThread) ? "main" : "worker",
+			Span->Depth,
+			StartupProfileMs(Span->StartTicks),
+			(Span->EndTicks > Span->StartTicks) ? stm_ms(Span->EndTicks - Span->StartTicks) : 0.0);
+	}
+	fprintf(File, "\n\t]\n}\n");
+
+	bool Written = !ferror(File);
+	Written = (fclose(File) == 0) && Written;
+	if (Written) {
+		LogInfo("Startup: Wrote profile with %d spans to '%s'", SpanCount, FileName);
+	} else {
+		LogError("Startup: Failed writing profile to '%s'", FileName);
+	}
+	return Written;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Types.h"
+
+// Timestamped startup phases, relative to launch. Recording is always on and cheap (a fixed array, no allocations),
+// the JSON report is only written when running in startup profile mode. Names must be string literals.
+
+#define STARTUP_PROFILE_MAX_SPANS 128
+#define STARTUP_PROFILE_MAX_VALUES 16
+#define STARTUP_PROFILE_MAX_DEPTH 8
+
+void StartupProfileInitialize(uint64 LaunchTicks);
+
+// Main thread only, phases nest.
+void StartupProfileBegin(const char* Name);
+void StartupProfileEnd(void);
+
+// A span measured elsewhere, e.g. on a job worker. Safe from any thread.
+void StartupProfileRecord(const char* Name, uint64 StartTicks, uint64 EndTicks);
+// Main thread only, a named number reported next to the spans (display count, decode totals...).
+void StartupProfileSetValue(const char* Name, double Value);
+
+// Call once all workers that record spans have been joined.
+bool StartupProfileWriteReport(const char* FileName);
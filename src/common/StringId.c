@@ -1,5 +1,9 @@
 #include "StringId.h"
 
+#include "MemoryTracker.h"
+
+#define STRPOOL_MALLOC(Context, Size) MemoryAlloc(MemoryTag_StringPool, Size)
+#define STRPOOL_FREE(Context, Pointer) MemoryFree(Pointer)
 #define STRPOOL_U32 uint32
 #define STPROOL_U64 uint64
 #define STRPOOL_IMPLEMENTATION
@@ -1,14 +1,32 @@
+#include "MemoryTracker.h"
+
 #define SOKOL_IMPL
 #include <sokol_time.h>
 
+#define STBDS_REALLOC(Context, Pointer, Size) MemoryRealloc(MemoryTag_StbDs, Pointer, Size)
+#define STBDS_FREE(Context, Pointer) MemoryFree(Pointer)
 #define STB_DS_IMPLEMENTATION
 #include "stb_ds.h"
 
+#define STBI_MALLOC(Size) MemoryAlloc(MemoryTag_StbImage, Size)
+#define STBI_REALLOC(Pointer, Size) MemoryRealloc(MemoryTag_StbImage, Pointer, Size)
+#define STBI_FREE(Pointer) MemoryFree(Pointer)
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#define STBIW_MALLOC(Size) MemoryAlloc(MemoryTag_StbImage, Size)
+#define STBIW_REALLOC(Pointer, Size) MemoryRealloc(MemoryTag_StbImage, Pointer, Size)
+#define STBIW_FREE(Pointer) MemoryFree(Pointer)
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
 
 #define RND_IMPLEMENTATION
 #include "Random.h"
+
+#if __LINUX__
+#define DIR_POSIX
+#else
+#define DIR_WINDOWS
+#endif
+#define DIR_IMPLEMENTATION
+#include <dir.h>
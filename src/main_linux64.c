@@ -1,13 +1,32 @@
 #include <SDL3/SDL.h>
+#include <sokol_time.h>
+#include <stb_ds.h>
 #include <stdlib.h>
 
 #include "common/Application.h"
 
+#include <X11/Xlib.h>
+
 Application *GApp = NULL;
 
 int main(int argc, char* argv[])
 {
-	Application* App = ApplicationInitialize(&(ApplicationConfig){});
+	// The desktop capture runs on a worker thread while SDL creates windows on the main thread.
+	XInitThreads();
+
+	ApplicationConfig Config = {};
+	for (int ArgIndex = 1; ArgIndex < argc; ArgIndex++) {
+		if (SDL_strcmp(argv[ArgIndex], "--live-desktop") == 0) {
+			Config.LiveDesktop = true;
+		} else if (SDL_strncmp(argv[ArgIndex], "--profile-startup", 17) == 0 &&
+				   (argv[ArgIndex][17] == '\0' || argv[ArgIndex][17] == '='))
+		{
+			// --profile-startup[=<report.json>]
+			Config.StartupProfilePath = argv[ArgIndex][17] ? &argv[ArgIndex][18] : "startup_profile.json";
+		}
+	}
+
+	Application* App = ApplicationInitialize(&Config);
 	GApp = App;
 	ApplicationRun(App);
 	ApplicationShutdown(App);
@@ -16,11 +35,206 @@ int main(int argc, char* argv[])
 
 SDL_NORETURN void PanicAndAbort(const char* Title, const char* Message)
 {
+	LogError("%s: %s", Title, Message);
+	LoggingFlush();
 	SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, Title, Message, GetApplicationWindow(GApp));
 	exit(1);
 }
 
-bool ApplicationTakeDesktopScreenshot(SDL_Surface **OutSurface)
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <X11/extensions/Xrandr.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+// Owns everything backing a captured desktop surface. The surface pixels point straight into Image->data (the shared
+// memory segment when MIT-SHM is available) so this must outlive the surface, it is released by the surface's
+// property cleanup.
+typedef struct X11Capture {
+	Display* XDisplay;
+	XImage* Image;
+	XShmSegmentInfo ShmInfo;
+	bool UsesShm;
+} X11Capture;
+
+static void X11CaptureDestroy(void* UserData, void* Value)
+{
+	X11Capture* Capture = (X11Capture*)Value;
+
+	if (Capture->UsesShm) {
+		XShmDetach(Capture->XDisplay, &Capture->ShmInfo);
+		XDestroyImage(Capture->Image);
+		shmdt(Capture->ShmInfo.shmaddr);
+	} else if (Capture->Image) {
+		XDestroyImage(Capture->Image);
+	}
+
+	XCloseDisplay(Capture->XDisplay);
+	SDL_free(Capture);
+}
+
+// MIT-SHM fails asynchronously: BadAccess from the attach on remote displays whose server can't map our segment,
+// BadMatch from XShmGetImage on some XWayland roots. Either only means falling back to XGetImage, Xlib's default
+// handler would exit instead.
+static struct {
+	Display* XDisplay; // Only errors on this connection are caught, NULL when not capturing
+	XErrorHandler PreviousErrorHandler;
+	int ErrorCode; // First error caught, Success when none
+} GX11CaptureErrors;
+
+static int X11CaptureErrorHandler(Display* XDisplay, XErrorEvent* Error)
+{
+	if (XDisplay != GX11CaptureErrors.XDisplay) {
+		return GX11CaptureErrors.PreviousErrorHandler ? GX11CaptureErrors.PreviousErrorHandler(XDisplay, Error) : 0;
+	}
+	if (GX11CaptureErrors.ErrorCode == Success) {
+		GX11CaptureErrors.ErrorCode = Error->error_code;
+	}
+	return 0;
+}
+
+// Logs What with the error caught since the handler was installed, if any.
+static void X11CaptureLogFailure(Display* XDisplay, const char* What)
+{
+	if (GX11CaptureErrors.ErrorCode != Success) {
+		char Text[128];
+		XGetErrorText(XDisplay, GX11CaptureErrors.ErrorCode, Text, sizeof(Text));
+		LogWarning("Screenshot: %s (%s)", What, Text);
+	} else {
+		LogWarning("Screenshot: %s", What);
+	}
+}
+
+static bool X11CaptureShm(X11Capture* Capture, Window Root, const XWindowAttributes* Attributes)
+{
+	if (!XShmQueryExtension(Capture->XDisplay)) {
+		LogWarning("Screenshot: MIT-SHM extension is unavailable");
+		return false;
+	}
+
+	XImage* Image = XShmCreateImage(
+		Capture->XDisplay,
+		Attributes->visual,
+		Attributes->depth,
+		ZPixmap,
+		NULL,
+		&Capture->ShmInfo,
+		Attributes->width,
+		Attributes->height);
+	if (Image == NULL) {
+		LogWarning("Screenshot: XShmCreateImage failed");
+		return false;
+	}
+
+	Capture->ShmInfo.shmid = shmget(IPC_PRIVATE, Image->bytes_per_line * Image->height, IPC_CREAT | 0600);
+	if (Capture->ShmInfo.shmid < 0) {
+		LogWarning("Screenshot: shmget failed for %d bytes", Image->bytes_per_line * Image->height);
+		XDestroyImage(Image);
+		return false;
+	}
+
+	Capture->ShmInfo.shmaddr = Image->data = shmat(Capture->ShmInfo.shmid, NULL, 0);
+	Capture->ShmInfo.readOnly = False;
+
+	GX11CaptureErrors.XDisplay = Capture->XDisplay;
+	GX11CaptureErrors.ErrorCode = Success;
+	GX11CaptureErrors.PreviousErrorHandler = XSetErrorHandler(X11CaptureErrorHandler);
+
+	bool Attached = Capture->ShmInfo.shmaddr != (char*)-1 && XShmAttach(Capture->XDisplay, &Capture->ShmInfo);
+	if (Attached) {
+		XSync(Capture->XDisplay, False);
+		Attached = GX11CaptureErrors.ErrorCode == Success;
+	}
+
+	// Mark the segment for removal now, it stays alive until both we and the X server have detached from it so it
+	// can never leak even if we crash.
+	shmctl(Capture->ShmInfo.shmid, IPC_RMID, NULL);
+
+	bool Captured = Attached && XShmGetImage(Capture->XDisplay, Root, Image, 0, 0, AllPlanes) &&
+					GX11CaptureErrors.ErrorCode == Success;
+	if (Attached && !Captured) {
+		X11CaptureLogFailure(Capture->XDisplay, "XShmGetImage failed");
+		XShmDetach(Capture->XDisplay, &Capture->ShmInfo);
+		XSync(Capture->XDisplay, False);
+	}
+
+	XSetErrorHandler(GX11CaptureErrors.PreviousErrorHandler);
+	GX11CaptureErrors.XDisplay = NULL;
+
+	if (!Attached) {
+		X11CaptureLogFailure(Capture->XDisplay, "Unable to attach shared memory segment");
+		if (Capture->ShmInfo.shmaddr != (char*)-1) {
+			shmdt(Capture->ShmInfo.shmaddr);
+		}
+		XDestroyImage(Image);
+		return false;
+	}
+
+	if (!Captured) {
+		XDestroyImage(Image);
+		shmdt(Capture->ShmInfo.shmaddr);
+		return false;
+	}
+
+	Capture->Image = Image;
+	Capture->UsesShm = true;
+	return true;
+}
+
+static bool X11CaptureGetImage(X11Capture* Capture, Window Root, const XWindowAttributes* Attributes)
+{
+	Capture->Image =
+		XGetImage(Capture->XDisplay, Root, 0, 0, Attributes->width, Attributes->height, AllPlanes, ZPixmap);
+	if (Capture->Image == NULL) {
+		LogWarning("Screenshot: XGetImage failed");
+		return false;
+	}
+	return true;
+}
+
+static SDL_PixelFormat X11ImagePixelFormat(const XImage* Image)
+{
+	if (Image->bits_per_pixel == 32 && Image->red_mask == 0xFF0000 && Image->green_mask == 0x00FF00 &&
+		Image->blue_mask == 0x0000FF)
+	{
+		return SDL_PIXELFORMAT_XRGB8888;
+	}
+	if (Image->bits_per_pixel == 16 && Image->red_mask == 0xF800 && Image->green_mask == 0x07E0 &&
+		Image->blue_mask == 0x001F)
+	{
+		return SDL_PIXELFORMAT_RGB565;
+	}
+	return SDL_PIXELFORMAT_UNKNOWN;
+}
+
+static void X11LogMonitors(Display* XDisplay, Window Root)
+{
+	int EventBase, ErrorBase;
+	if (!XRRQueryExtension(XDisplay, &EventBase, &ErrorBase)) {
+		LogInfo("Screenshot: RandR unavailable, treating the desktop as a single monitor");
+		return;
+	}
+
+	int MonitorCount = 0;
+	XRRMonitorInfo* Monitors = XRRGetMonitors(XDisplay, Root, True, &MonitorCount);
+	for (int MonitorIndex = 0; MonitorIndex < MonitorCount; MonitorIndex++) {
+		const XRRMonitorInfo* Monitor = &Monitors[MonitorIndex];
+		LogInfo(
+			"Screenshot: Monitor %d at (%d, %d) %dx%d%s",
+			MonitorIndex,
+			Monitor->x,
+			Monitor->y,
+			Monitor->width,
+			Monitor->height,
+			Monitor->primary ? " (primary)" : "");
+	}
+	if (Monitors) {
+		XRRFreeMonitors(Monitors);
+	}
+}
+
+static bool CreatePlaceholderScreenshot(SDL_Surface** OutSurface)
 {
 	*OutSurface = SDL_CreateSurface(640, 480, SDL_PIXELFORMAT_RGBA32);
 	if (*OutSurface == NULL) {
@@ -28,6 +242,700 @@ bool ApplicationTakeDesktopScreenshot(SDL_Surface **OutSurface)
 	}
 
 	SDL_FillSurfaceRect(*OutSurface, NULL, SDL_MapSurfaceRGB(*OutSurface, 64, 128, 255));
-	
+
 	return true;
-}
\ No newline at end of file
+}
+
+bool ApplicationTakeDesktopScreenshot(SDL_Surface** OutSurface)
+{
+	*OutSurface = NULL;
+
+	uint64 StartTicks = stm_now();
+
+	X11Capture* Capture = SDL_malloc(sizeof(X11Capture));
+	SDL_zerop(Capture);
+
+	Capture->XDisplay = XOpenDisplay(NULL);
+	if (Capture->XDisplay == NULL) {
+		LogWarning("Screenshot: Unable to open X display, using placeholder screenshot");
+		SDL_free(Capture);
+		return CreatePlaceholderScreenshot(OutSurface);
+	}
+
+	// The root window spans the whole virtual desktop across every monitor.
+	Window Root = DefaultRootWindow(Capture->XDisplay);
+	XWindowAttributes Attributes;
+	XGetWindowAttributes(Capture->XDisplay, Root, &Attributes);
+
+	X11LogMonitors(Capture->XDisplay, Root);
+
+	if (!X11CaptureShm(Capture, Root, &Attributes)) {
+		LogWarning("Screenshot: Falling back to XGetImage");
+		if (!X11CaptureGetImage(Capture, Root, &Attributes)) {
+			X11CaptureDestroy(NULL, Capture);
+			return CreatePlaceholderScreenshot(OutSurface);
+		}
+	}
+
+	SDL_PixelFormat Format = X11ImagePixelFormat(Capture->Image);
+	SDL_Surface* Surface = NULL;
+	if (Format != SDL_PIXELFORMAT_UNKNOWN) {
+		Surface = SDL_CreateSurfaceFrom(
+			Capture->Image->width,
+			Capture->Image->height,
+			Format,
+			Capture->Image->data,
+			Capture->Image->bytes_per_line);
+	} else {
+		LogWarning(
+			"Screenshot: Unsupported X image format (%d bpp, masks %06lx %06lx %06lx)",
+			Capture->Image->bits_per_pixel,
+			Capture->Image->red_mask,
+			Capture->Image->green_mask,
+			Capture->Image->blue_mask);
+	}
+
+	if (Surface == NULL) {
+		X11CaptureDestroy(NULL, Capture);
+		return CreatePlaceholderScreenshot(OutSurface);
+	}
+
+	SDL_SetPointerPropertyWithCleanup(
+		SDL_GetSurfaceProperties(Surface),
+		"shaver.x11.capture",
+		Capture,
+		X11CaptureDestroy,
+		NULL);
+
+	LogInfo(
+		"Screenshot: Captured %dx%d desktop via %s in %.2f ms",
+		Surface->w,
+		Surface->h,
+		Capture->UsesShm ? "MIT-SHM" : "XGetImage",
+		stm_ms(stm_since(StartTicks)));
+
+	*OutSurface = Surface;
+	return true;
+}
+
+#include <X11/extensions/Xcomposite.h>
+#include <X11/extensions/Xdamage.h>
+#include <X11/extensions/damagewire.h>
+#include <X11/extensions/Xfixes.h>
+
+// Live desktop keeps the screenshot in sync with the desktop underneath our own fullscreen windows. The root window
+// can't be recaptured since our windows are drawn into it, so instead every other top level window is redirected
+// (automatically, the server keeps compositing as before) which keeps its contents available even while we cover it.
+// Damage is tracked per window and only the damaged rects are read back, bottom to top, through one MIT-SHM scratch
+// segment. Each read back is a round trip on the frame thread, so overlapping rects are merged first and a frame only
+// reads back so much, the rest waits for the next one.
+
+#define LIVE_DESKTOP_MAX_DIRTY_RECTS 32
+#define LIVE_DESKTOP_REPORT_INTERVAL_MS 5000.0
+// Dirty pixels recomposed per frame, 4 MB of 32-bit pixels.
+#define LIVE_DESKTOP_FRAME_BUDGET_PIXELS (1024 * 1024)
+#define LIVE_DESKTOP_GONE_WINDOWS 64
+#define LIVE_DESKTOP_MAX_PENDING_ERRORS 16
+
+typedef struct X11LiveWindow {
+	Window Window;
+	Damage Damage;
+	SDL_Rect Rect; // Inner rect in root coordinates
+	bool Mapped;
+} X11LiveWindow;
+
+// A window that was destroyed or unmapped, requests already on their way for it fail.
+typedef struct X11GoneWindow {
+	Window Window;
+	Damage Damage;
+} X11GoneWindow;
+
+typedef struct X11PendingError {
+	XErrorEvent Error;
+	Window Target; // Window of the round trip the error came back on, errors like BadMatch don't name one
+} X11PendingError;
+
+typedef struct X11LiveDesktop {
+	Display* XDisplay;
+	Window Root;
+	Visual* Visual;
+	int Depth;
+	int DamageEventBase;
+	int DamageErrorBase;
+	XserverRegion Region;
+	XShmSegmentInfo ShmInfo;
+	SDL_Surface* Screenshot;
+	Window* OwnWindows;
+	X11LiveWindow* Windows;
+	SDL_Rect* DirtyRects;
+	uint64 BytesCaptured;
+	uint32 RectsCaptured;
+	uint32 RectsDeferred;
+	uint64 ReportTicks;
+	XErrorHandler PreviousErrorHandler;
+	Window RequestWindow; // Target of the round trip in flight
+	X11GoneWindow GoneWindows[LIVE_DESKTOP_GONE_WINDOWS]; // Ring of the most recent ones
+	int NextGoneWindow;
+	X11PendingError PendingErrors[LIVE_DESKTOP_MAX_PENDING_ERRORS];
+	int PendingErrorCount;
+	int DroppedErrorCount;
+} X11LiveDesktop;
+
+static X11LiveDesktop GLiveDesktop;
+
+static int X11LiveDesktopErrorHandler(Display* XDisplay, XErrorEvent* Error)
+{
+	// Anything not on our connection belongs to SDL.
+	if (XDisplay != GLiveDesktop.XDisplay) {
+		return GLiveDesktop.PreviousErrorHandler ? GLiveDesktop.PreviousErrorHandler(XDisplay, Error) : 0;
+	}
+
+	// No requests are allowed in here. Errors are judged once the events queued ahead of them have been handled, the
+	// DestroyNotify of a window that vanished under a request always comes before the error.
+	if (GLiveDesktop.PendingErrorCount < LIVE_DESKTOP_MAX_PENDING_ERRORS) {
+		GLiveDesktop.PendingErrors[GLiveDesktop.PendingErrorCount++] =
+			(X11PendingError){*Error, GLiveDesktop.RequestWindow};
+	} else {
+		GLiveDesktop.DroppedErrorCount++;
+	}
+	return 0;
+}
+
+static void X11LiveDesktopMarkGone(Window Window, Damage Damage)
+{
+	GLiveDesktop.GoneWindows[GLiveDesktop.NextGoneWindow] = (X11GoneWindow){Window, Damage};
+	GLiveDesktop.NextGoneWindow = (GLiveDesktop.NextGoneWindow + 1) % LIVE_DESKTOP_GONE_WINDOWS;
+}
+
+static bool X11LiveDesktopIsGone(XID Resource)
+{
+	for (int Index = 0; Resource != None && Index < LIVE_DESKTOP_GONE_WINDOWS; Index++) {
+		const X11GoneWindow* Gone = &GLiveDesktop.GoneWindows[Index];
+		if (Gone->Window == Resource || Gone->Damage == Resource) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Windows can go away between an event and our request for them, which fails the request for a window that's gone.
+static bool X11LiveDesktopIsExpectedError(const X11PendingError* Pending)
+{
+	int Code = Pending->Error.error_code;
+	bool GoneWindowError = Code == BadWindow || Code == BadDrawable || Code == BadMatch ||
+						   Code == GLiveDesktop.DamageErrorBase + BadDamage;
+	return GoneWindowError &&
+		   (X11LiveDesktopIsGone(Pending->Error.resourceid) || X11LiveDesktopIsGone(Pending->Target));
+}
+
+// Logs every pending error that isn't expected and returns how many there were.
+static int X11LiveDesktopReportErrors(void)
+{
+	int Unexpected = 0;
+	for (int Index = 0; Index < GLiveDesktop.PendingErrorCount; Index++) {
+		const XErrorEvent* Error = &GLiveDesktop.PendingErrors[Index].Error;
+		if (X11LiveDesktopIsExpectedError(&GLiveDesktop.PendingErrors[Index])) {
+			continue;
+		}
+		char Text[128];
+		XGetErrorText(GLiveDesktop.XDisplay, Error->error_code, Text, sizeof(Text));
+		LogWarning(
+			"LiveDesktop: X error %s (request %d.%d, resource 0x%lx)",
+			Text,
+			Error->request_code,
+			Error->minor_code,
+			Error->resourceid);
+		Unexpected++;
+	}
+	if (GLiveDesktop.DroppedErrorCount > 0) {
+		LogWarning("LiveDesktop: %d more X error(s) not shown", GLiveDesktop.DroppedErrorCount);
+		Unexpected += GLiveDesktop.DroppedErrorCount;
+	}
+
+	GLiveDesktop.PendingErrorCount = 0;
+	GLiveDesktop.DroppedErrorCount = 0;
+	return Unexpected;
+}
+
+static bool X11LiveDesktopIsOwnWindow(Window Candidate)
+{
+	for (int Index = 0; Index < arrlen(GLiveDesktop.OwnWindows); Index++) {
+		if (GLiveDesktop.OwnWindows[Index] == Candidate) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Returns the child of the root window that contains Window, which is the frame when a window manager reparents.
+static Window X11FindTopLevel(Display* XDisplay, Window Root, Window Child)
+{
+	for (;;) {
+		Window RootReturn, Parent;
+		Window* Children = NULL;
+		unsigned int ChildCount = 0;
+		if (!XQueryTree(XDisplay, Child, &RootReturn, &Parent, &Children, &ChildCount)) {
+			return None;
+		}
+		if (Children) {
+			XFree(Children);
+		}
+		if (Parent == Root || Parent == None) {
+			return Child;
+		}
+		Child = Parent;
+	}
+}
+
+static X11LiveWindow* X11LiveDesktopFindWindow(Window Window)
+{
+	for (int Index = 0; Index < arrlen(GLiveDesktop.Windows); Index++) {
+		if (GLiveDesktop.Windows[Index].Window == Window) {
+			return &GLiveDesktop.Windows[Index];
+		}
+	}
+	return NULL;
+}
+
+static void X11LiveDesktopAddDirty(const SDL_Rect* Rect)
+{
+	const SDL_Rect Desktop = {0, 0, GLiveDesktop.Screenshot->w, GLiveDesktop.Screenshot->h};
+	SDL_Rect Clipped;
+	if (!SDL_GetRectIntersection(Rect, &Desktop, &Clipped)) {
+		return;
+	}
+
+	// Past a point it is cheaper to read back one bounding box than to track many small rects.
+	if (arrlen(GLiveDesktop.DirtyRects) == LIVE_DESKTOP_MAX_DIRTY_RECTS) {
+		SDL_Rect Bounds = Clipped;
+		for (int Index = 0; Index < arrlen(GLiveDesktop.DirtyRects); Index++) {
+			SDL_GetRectUnion(&Bounds, &GLiveDesktop.DirtyRects[Index], &Bounds);
+		}
+		arrsetlen(GLiveDesktop.DirtyRects, 0);
+		arrput(GLiveDesktop.DirtyRects, Bounds);
+		return;
+	}
+
+	arrput(GLiveDesktop.DirtyRects, Clipped);
+}
+
+static bool X11LiveDesktopUpdateWindowRect(X11LiveWindow* LiveWindow)
+{
+	XWindowAttributes Attributes;
+	if (!XGetWindowAttributes(GLiveDesktop.XDisplay, LiveWindow->Window, &Attributes)) {
+		return false;
+	}
+	LiveWindow->Rect = (SDL_Rect){
+		Attributes.x + Attributes.border_width,
+		Attributes.y + Attributes.border_width,
+		Attributes.width,
+		Attributes.height,
+	};
+	LiveWindow->Mapped = Attributes.map_state == IsViewable && Attributes.depth == GLiveDesktop.Depth;
+	return true;
+}
+
+static void X11LiveDesktopTrackWindow(Window Window)
+{
+	if (X11LiveDesktopIsOwnWindow(Window) || X11LiveDesktopFindWindow(Window) != NULL) {
+		return;
+	}
+
+	X11LiveWindow LiveWindow = {.Window = Window};
+	if (!X11LiveDesktopUpdateWindowRect(&LiveWindow)) {
+		return;
+	}
+
+	LiveWindow.Damage = XDamageCreate(GLiveDesktop.XDisplay, Window, XDamageReportNonEmpty);
+	arrput(GLiveDesktop.Windows, LiveWindow);
+
+	if (LiveWindow.Mapped) {
+		X11LiveDesktopAddDirty(&LiveWindow.Rect);
+	}
+}
+
+static void X11LiveDesktopUntrackWindow(Window Window, bool Destroyed)
+{
+	for (int Index = 0; Index < arrlen(GLiveDesktop.Windows); Index++) {
+		X11LiveWindow* LiveWindow = &GLiveDesktop.Windows[Index];
+		if (LiveWindow->Window == Window) {
+			// Whatever was underneath shows through now.
+			X11LiveDesktopAddDirty(&LiveWindow->Rect);
+			if (Destroyed) {
+				X11LiveDesktopMarkGone(Window, LiveWindow->Damage);
+			} else {
+				XDamageDestroy(GLiveDesktop.XDisplay, LiveWindow->Damage);
+			}
+			arrdelswap(GLiveDesktop.Windows, Index);
+			return;
+		}
+	}
+}
+
+static void X11LiveDesktopHandleDamage(const XDamageNotifyEvent* Event)
+{
+	X11LiveWindow* LiveWindow = X11LiveDesktopFindWindow(Event->drawable);
+	if (LiveWindow == NULL) {
+		return;
+	}
+
+	XDamageSubtract(GLiveDesktop.XDisplay, Event->damage, None, GLiveDesktop.Region);
+
+	int RectCount = 0;
+	XRectangle* Rects = XFixesFetchRegion(GLiveDesktop.XDisplay, GLiveDesktop.Region, &RectCount);
+	for (int RectIndex = 0; RectIndex < RectCount; RectIndex++) {
+		SDL_Rect Damaged = {
+			LiveWindow->Rect.x + Rects[RectIndex].x,
+			LiveWindow->Rect.y + Rects[RectIndex].y,
+			Rects[RectIndex].width,
+			Rects[RectIndex].height,
+		};
+		if (LiveWindow->Mapped) {
+			X11LiveDesktopAddDirty(&Damaged);
+		}
+	}
+	if (Rects) {
+		XFree(Rects);
+	}
+}
+
+static void X11LiveDesktopHandleEvent(const XEvent* Event)
+{
+	if (Event->type == GLiveDesktop.DamageEventBase + XDamageNotify) {
+		X11LiveDesktopHandleDamage((const XDamageNotifyEvent*)Event);
+		return;
+	}
+
+	switch (Event->type) {
+	case CreateNotify:
+		X11LiveDesktopTrackWindow(Event->xcreatewindow.window);
+		break;
+	case DestroyNotify:
+		X11LiveDesktopUntrackWindow(Event->xdestroywindow.window, true);
+		break;
+	case MapNotify:
+	case UnmapNotify:
+	case ConfigureNotify: {
+		Window EventWindow = (Event->type == MapNotify)		? Event->xmap.window
+							 : (Event->type == UnmapNotify) ? Event->xunmap.window
+															: Event->xconfigure.window;
+		X11LiveWindow* LiveWindow = X11LiveDesktopFindWindow(EventWindow);
+		if (LiveWindow != NULL && Event->type == UnmapNotify) {
+			// Unmapped windows have no contents to read back, reads already on their way fail with BadMatch.
+			X11LiveDesktopMarkGone(EventWindow, None);
+		}
+		if (LiveWindow != NULL) {
+			X11LiveDesktopAddDirty(&LiveWindow->Rect);
+			X11LiveDesktopUpdateWindowRect(LiveWindow);
+			if (LiveWindow->Mapped) {
+				X11LiveDesktopAddDirty(&LiveWindow->Rect);
+			}
+		}
+	} break;
+	case ReparentNotify:
+		if (Event->xreparent.parent == GLiveDesktop.Root) {
+			X11LiveDesktopTrackWindow(Event->xreparent.window);
+		} else {
+			X11LiveDesktopUntrackWindow(Event->xreparent.window, false);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+// Reads Rect (root coordinates, inside LiveWindow) back from the window's own contents into the screenshot.
+static void X11LiveDesktopCaptureRect(const X11LiveWindow* LiveWindow, const SDL_Rect* Rect)
+{
+	XImage* Image = XShmCreateImage(
+		GLiveDesktop.XDisplay,
+		GLiveDesktop.Visual,
+		GLiveDesktop.Depth,
+		ZPixmap,
+		GLiveDesktop.ShmInfo.shmaddr,
+		&GLiveDesktop.ShmInfo,
+		Rect->w,
+		Rect->h);
+	if (Image == NULL) {
+		return;
+	}
+
+	GLiveDesktop.RequestWindow = LiveWindow->Window;
+	bool Captured = XShmGetImage(
+		GLiveDesktop.XDisplay,
+		LiveWindow->Window,
+		Image,
+		Rect->x - LiveWindow->Rect.x,
+		Rect->y - LiveWindow->Rect.y,
+		AllPlanes);
+	GLiveDesktop.RequestWindow = None;
+
+	if (Captured) {
+		SDL_Surface* Screenshot = GLiveDesktop.Screenshot;
+		int BytesPerPixel = SDL_BYTESPERPIXEL(Screenshot->format);
+		int RowBytes = Rect->w * BytesPerPixel;
+		uint8* Dst = (uint8*)Screenshot->pixels + Rect->y * Screenshot->pitch + Rect->x * BytesPerPixel;
+		const uint8* Src = (const uint8*)Image->data;
+		for (int Row = 0; Row < Rect->h; Row++) {
+			SDL_memcpy(Dst, Src, RowBytes);
+			Dst += Screenshot->pitch;
+			Src += Image->bytes_per_line;
+		}
+		GLiveDesktop.BytesCaptured += (uint64)Image->bytes_per_line * Rect->h;
+	}
+
+	// Shared memory images don't own their data, this only frees the XImage header.
+	XDestroyImage(Image);
+}
+
+// Rebuilds a dirty rect from every window overlapping it in stacking order so overlaps come out right. Areas not
+// covered by any window keep their previous contents since the root background can't be read without our windows.
+static void X11LiveDesktopRecompose(const SDL_Rect* Dirty, const Window* Stack, unsigned int StackCount)
+{
+	for (unsigned int StackIndex = 0; StackIndex < StackCount; StackIndex++) {
+		const X11LiveWindow* LiveWindow = X11LiveDesktopFindWindow(Stack[StackIndex]);
+		SDL_Rect Visible;
+		if (LiveWindow == NULL || !LiveWindow->Mapped || !SDL_GetRectIntersection(Dirty, &LiveWindow->Rect, &Visible)) {
+			continue;
+		}
+		X11LiveDesktopCaptureRect(LiveWindow, &Visible);
+	}
+	GLiveDesktop.RectsCaptured++;
+}
+
+// Merges dirty rects whose bounding box is no bigger than the two of them, so overlapping and adjacent rects cost one
+// read back per window instead of two.
+static void X11LiveDesktopCoalesceDirty(void)
+{
+	SDL_Rect* Rects = GLiveDesktop.DirtyRects;
+	for (int First = 0; First < arrlen(GLiveDesktop.DirtyRects); First++) {
+		int Second = First + 1;
+		while (Second < arrlen(GLiveDesktop.DirtyRects)) {
+			SDL_Rect Union;
+			SDL_GetRectUnion(&Rects[First], &Rects[Second], &Union);
+			if ((int64)Union.w * Union.h <=
+				(int64)Rects[First].w * Rects[First].h + (int64)Rects[Second].w * Rects[Second].h)
+			{
+				Rects[First] = Union;
+				arrdelswap(GLiveDesktop.DirtyRects, Second);
+				// The grown rect may swallow ones it was already compared against.
+				Second = First + 1;
+			} else {
+				Second++;
+			}
+		}
+	}
+}
+
+static void X11LiveDesktopHandleEvents(void)
+{
+	while (XPending(GLiveDesktop.XDisplay)) {
+		XEvent Event;
+		XNextEvent(GLiveDesktop.XDisplay, &Event);
+		X11LiveDesktopHandleEvent(&Event);
+	}
+}
+
+bool ApplicationBeginLiveDesktop(SDL_Surface* Screenshot, SDL_Window** OwnWindows, int OwnWindowCount)
+{
+	SDL_zero(GLiveDesktop);
+
+	if (SDL_GetPointerProperty(SDL_GetSurfaceProperties(Screenshot), "shaver.x11.capture", NULL) == NULL) {
+		LogWarning("LiveDesktop: Screenshot isn't an X11 capture, live desktop disabled");
+		return false;
+	}
+
+	Display* XDisplay = XOpenDisplay(NULL);
+	if (XDisplay == NULL) {
+		LogWarning("LiveDesktop: Unable to open X display, live desktop disabled");
+		return false;
+	}
+
+	int CompositeEventBase, CompositeErrorBase, FixesEventBase, FixesErrorBase;
+	if (!XShmQueryExtension(XDisplay) ||
+		!XDamageQueryExtension(XDisplay, &GLiveDesktop.DamageEventBase, &GLiveDesktop.DamageErrorBase) ||
+		!XCompositeQueryExtension(XDisplay, &CompositeEventBase, &CompositeErrorBase) ||
+		!XFixesQueryExtension(XDisplay, &FixesEventBase, &FixesErrorBase))
+	{
+		LogWarning("LiveDesktop: MIT-SHM, DAMAGE, Composite and XFIXES are required, live desktop disabled");
+		XCloseDisplay(XDisplay);
+		return false;
+	}
+
+	int Major = 1, Minor = 1;
+	XDamageQueryVersion(XDisplay, &Major, &Minor);
+	Major = 2, Minor = 0;
+	XFixesQueryVersion(XDisplay, &Major, &Minor);
+
+	GLiveDesktop.XDisplay = XDisplay;
+	GLiveDesktop.Root = DefaultRootWindow(XDisplay);
+	GLiveDesktop.Screenshot = Screenshot;
+	GLiveDesktop.PreviousErrorHandler = XSetErrorHandler(X11LiveDesktopErrorHandler);
+
+	XWindowAttributes RootAttributes;
+	XGetWindowAttributes(XDisplay, GLiveDesktop.Root, &RootAttributes);
+	GLiveDesktop.Visual = RootAttributes.visual;
+	GLiveDesktop.Depth = RootAttributes.depth;
+
+	// Scratch segment large enough for a full desktop read back.
+	size_t ScratchSize = (size_t)Screenshot->pitch * Screenshot->h;
+	GLiveDesktop.ShmInfo.shmid = shmget(IPC_PRIVATE, ScratchSize, IPC_CREAT | 0600);
+	GLiveDesktop.ShmInfo.shmaddr =
+		(GLiveDesktop.ShmInfo.shmid >= 0) ? shmat(GLiveDesktop.ShmInfo.shmid, NULL, 0) : (char*)-1;
+	GLiveDesktop.ShmInfo.readOnly = False;
+	bool Attached = GLiveDesktop.ShmInfo.shmaddr != (char*)-1 && XShmAttach(XDisplay, &GLiveDesktop.ShmInfo);
+	XSync(XDisplay, False);
+	// Attaching fails asynchronously, e.g. with BadAccess on a remote display.
+	Attached = X11LiveDesktopReportErrors() == 0 && Attached;
+	if (GLiveDesktop.ShmInfo.shmid >= 0) {
+		shmctl(GLiveDesktop.ShmInfo.shmid, IPC_RMID, NULL);
+	}
+	if (!Attached) {
+		LogWarning("LiveDesktop: Unable to attach %zu byte scratch segment, live desktop disabled", ScratchSize);
+		if (GLiveDesktop.ShmInfo.shmaddr != (char*)-1) {
+			shmdt(GLiveDesktop.ShmInfo.shmaddr);
+		}
+		XSetErrorHandler(GLiveDesktop.PreviousErrorHandler);
+		XCloseDisplay(XDisplay);
+		SDL_zero(GLiveDesktop);
+		return false;
+	}
+
+	for (int Index = 0; Index < OwnWindowCount; Index++) {
+		Window OwnWindow = (Window)SDL_GetNumberProperty(
+			SDL_GetWindowProperties(OwnWindows[Index]),
+			SDL_PROP_WINDOW_X11_WINDOW_NUMBER,
+			0);
+		if (OwnWindow != None) {
+			arrput(GLiveDesktop.OwnWindows, X11FindTopLevel(XDisplay, GLiveDesktop.Root, OwnWindow));
+		}
+	}
+
+	GLiveDesktop.Region = XFixesCreateRegion(XDisplay, NULL, 0);
+	XCompositeRedirectSubwindows(XDisplay, GLiveDesktop.Root, CompositeRedirectAutomatic);
+	XSelectInput(XDisplay, GLiveDesktop.Root, SubstructureNotifyMask);
+
+	Window RootReturn, Parent;
+	Window* Children = NULL;
+	unsigned int ChildCount = 0;
+	XQueryTree(XDisplay, GLiveDesktop.Root, &RootReturn, &Parent, &Children, &ChildCount);
+	for (unsigned int ChildIndex = 0; ChildIndex < ChildCount; ChildIndex++) {
+		X11LiveDesktopTrackWindow(Children[ChildIndex]);
+	}
+	if (Children) {
+		XFree(Children);
+	}
+
+	// The initial capture is already current, only changes from here on matter.
+	arrsetlen(GLiveDesktop.DirtyRects, 0);
+	GLiveDesktop.ReportTicks = stm_now();
+
+	LogInfo(
+		"LiveDesktop: Tracking %d window(s), excluding %d of our own",
+		(int)arrlen(GLiveDesktop.Windows),
+		(int)arrlen(GLiveDesktop.OwnWindows));
+
+	return true;
+}
+
+int ApplicationPollLiveDesktop(SDL_Rect* OutRects, int MaxRects)
+{
+	if (GLiveDesktop.XDisplay == NULL) {
+		return 0;
+	}
+
+	// Errors from the previous poll's reads are judged after the events that came in ahead of them.
+	X11LiveDesktopHandleEvents();
+	X11LiveDesktopReportErrors();
+
+	int RectCount = 0;
+	if (arrlen(GLiveDesktop.DirtyRects) > 0) {
+		X11LiveDesktopCoalesceDirty();
+
+		Window RootReturn, Parent;
+		Window* Stack = NULL;
+		unsigned int StackCount = 0;
+		XQueryTree(GLiveDesktop.XDisplay, GLiveDesktop.Root, &RootReturn, &Parent, &Stack, &StackCount);
+
+		// Rects are taken in order until the budget runs out. The one that doesn't fit has a band off its top read back
+		// and keeps the rest, which goes first on the next frame.
+		SDL_Rect Captured[LIVE_DESKTOP_MAX_DIRTY_RECTS];
+		int CapturedCount = 0;
+		int FinishedCount = 0;
+		int64 Budget = LIVE_DESKTOP_FRAME_BUDGET_PIXELS;
+		while (FinishedCount < arrlen(GLiveDesktop.DirtyRects) && Budget > 0) {
+			SDL_Rect* Dirty = &GLiveDesktop.DirtyRects[FinishedCount];
+			int Rows = (int)SDL_min((int64)Dirty->h, SDL_max(Budget / Dirty->w, 1));
+			SDL_Rect Band = {Dirty->x, Dirty->y, Dirty->w, Rows};
+			X11LiveDesktopRecompose(&Band, Stack, StackCount);
+			Captured[CapturedCount++] = Band;
+			Budget -= (int64)Band.w * Band.h;
+
+			if (Rows < Dirty->h) {
+				Dirty->y += Rows;
+				Dirty->h -= Rows;
+				break;
+			}
+			FinishedCount++;
+		}
+		GLiveDesktop.RectsDeferred += (uint32)(arrlen(GLiveDesktop.DirtyRects) - FinishedCount);
+		arrdeln(GLiveDesktop.DirtyRects, 0, FinishedCount);
+
+		if (Stack) {
+			XFree(Stack);
+		}
+
+		// Hand back the individual rects when they fit, the caller only needs to cover them.
+		RectCount = CapturedCount;
+		if (RectCount <= MaxRects) {
+			SDL_memcpy(OutRects, Captured, RectCount * sizeof(SDL_Rect));
+		} else if (MaxRects > 0) {
+			OutRects[0] = Captured[0];
+			for (int Index = 1; Index < RectCount; Index++) {
+				SDL_GetRectUnion(&OutRects[0], &Captured[Index], &OutRects[0]);
+			}
+			RectCount = 1;
+		}
+	}
+
+	double ElapsedMs = stm_ms(stm_since(GLiveDesktop.ReportTicks));
+	if (ElapsedMs >= LIVE_DESKTOP_REPORT_INTERVAL_MS) {
+		double Seconds = ElapsedMs / 1000.0;
+		LogInfo(
+			"LiveDesktop: Captured %.2f KB/s in %.1f rects/s, %.1f rects/s deferred by the frame budget",
+			(double)GLiveDesktop.BytesCaptured / 1024.0 / Seconds,
+			(double)GLiveDesktop.RectsCaptured / Seconds,
+			(double)GLiveDesktop.RectsDeferred / Seconds);
+		GLiveDesktop.BytesCaptured = 0;
+		GLiveDesktop.RectsCaptured = 0;
+		GLiveDesktop.RectsDeferred = 0;
+		GLiveDesktop.ReportTicks = stm_now();
+	}
+
+	return RectCount;
+}
+
+void ApplicationEndLiveDesktop(void)
+{
+	if (GLiveDesktop.XDisplay == NULL) {
+		return;
+	}
+
+	for (int Index = 0; Index < arrlen(GLiveDesktop.Windows); Index++) {
+		XDamageDestroy(GLiveDesktop.XDisplay, GLiveDesktop.Windows[Index].Damage);
+	}
+	XFixesDestroyRegion(GLiveDesktop.XDisplay, GLiveDesktop.Region);
+	XCompositeUnredirectSubwindows(GLiveDesktop.XDisplay, GLiveDesktop.Root, CompositeRedirectAutomatic);
+	XShmDetach(GLiveDesktop.XDisplay, &GLiveDesktop.ShmInfo);
+	XSync(GLiveDesktop.XDisplay, False);
+	X11LiveDesktopHandleEvents();
+	X11LiveDesktopReportErrors();
+	shmdt(GLiveDesktop.ShmInfo.shmaddr);
+	XSetErrorHandler(GLiveDesktop.PreviousErrorHandler);
+	XCloseDisplay(GLiveDesktop.XDisplay);
+
+	arrfree(GLiveDesktop.OwnWindows);
+	arrfree(GLiveDesktop.Windows);
+	arrfree(GLiveDesktop.DirtyRects);
+	SDL_zero(GLiveDesktop);
+}
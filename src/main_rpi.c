@@ -7,7 +7,17 @@ Application *GApp = NULL;
 
 int main(int argc, char* argv[])
 {
-	Application* App = ApplicationInitialize(&(ApplicationConfig){});
+	ApplicationConfig Config = {};
+	for (int ArgIndex = 1; ArgIndex < argc; ArgIndex++) {
+		if (SDL_strncmp(argv[ArgIndex], "--profile-startup", 17) == 0 &&
+			(argv[ArgIndex][17] == '\0' || argv[ArgIndex][17] == '='))
+		{
+			// --profile-startup[=<report.json>]
+			Config.StartupProfilePath = argv[ArgIndex][17] ? &argv[ArgIndex][18] : "startup_profile.json";
+		}
+	}
+
+	Application* App = ApplicationInitialize(&Config);
 	GApp = App;
 	ApplicationRun(App);
 	ApplicationShutdown(App);
@@ -16,6 +26,25 @@ int main(int argc, char* argv[])
 
 SDL_NORETURN void PanicAndAbort(const char* Title, const char* Message)
 {
+	LogError("%s: %s", Title, Message);
+	LoggingFlush();
 	SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, Title, Message, GetApplicationWindow(GApp));
 	exit(1);
-}
\ No newline at end of file
+}
+
+
+// Live desktop needs damage tracking from the platform, the frozen screenshot is used instead.
+bool ApplicationBeginLiveDesktop(SDL_Surface* Screenshot, SDL_Window** OwnWindows, int OwnWindowCount)
+{
+	LogWarning("LiveDesktop: Not supported on this platform");
+	return false;
+}
+
+int ApplicationPollLiveDesktop(SDL_Rect* OutRects, int MaxRects)
+{
+	return 0;
+}
+
+void ApplicationEndLiveDesktop(void)
+{
+}
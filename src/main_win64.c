@@ -2,6 +2,8 @@
 #include <SDL3/SDL_main.h>
 #include <stdlib.h>
 #include "common/Application.h"
+#include "common/LargeAlloc.h"
+#include "common/PixelConvert.h"
 
 #include <SDL3/SDL.h>
 
@@ -9,7 +11,17 @@ Application *GApp = NULL;
 
 int main(int argc, char* argv[])
 {
-	Application* App = ApplicationInitialize(&(ApplicationConfig){});
+	ApplicationConfig Config = {};
+	for (int ArgIndex = 1; ArgIndex < argc; ArgIndex++) {
+		if (SDL_strncmp(argv[ArgIndex], "--profile-startup", 17) == 0 &&
+			(argv[ArgIndex][17] == '\0' || argv[ArgIndex][17] == '='))
+		{
+			// --profile-startup[=<report.json>]
+			Config.StartupProfilePath = argv[ArgIndex][17] ? &argv[ArgIndex][18] : "startup_profile.json";
+		}
+	}
+
+	Application* App = ApplicationInitialize(&Config);
 
 	GApp = App;
 	ApplicationRun(App);
@@ -20,6 +32,8 @@ int main(int argc, char* argv[])
 
 SDL_NORETURN void PanicAndAbort(const char* Title, const char* Message)
 {
+	LogError("%s: %s", Title, Message);
+	LoggingFlush();
 	SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, Title, Message, GetApplicationWindow(GApp));
 	exit(1);
 }
@@ -49,6 +63,13 @@ bool ApplicationTakeDesktopScreenshot(SDL_Surface **OutSurface)
 	BYTE* lpBitmapBits = NULL;
 
 	HBITMAP hBitmap = CreateDIBSection(hScreenDC, &bi, DIB_RGB_COLORS, (LPVOID*)&lpBitmapBits, NULL, 0);
+	if (hBitmap == NULL) {
+		LogWarning("Screenshot: CreateDIBSection failed for %dx%d", width, height);
+		DeleteDC(hMemoryDC);
+		ReleaseDC(NULL, hScreenDC);
+		*OutSurface = NULL;
+		return false;
+	}
 	HBITMAP hOldBitmap = SDL_static_cast(HBITMAP, SelectObject(hMemoryDC, hBitmap));
 	BitBlt(hMemoryDC, 0, 0, width, height, hScreenDC, 0, 0, SRCCOPY);
 	hBitmap = SDL_static_cast(HBITMAP, SelectObject(hMemoryDC, hOldBitmap));
@@ -59,23 +80,52 @@ bool ApplicationTakeDesktopScreenshot(SDL_Surface **OutSurface)
 	BITMAP oldBitmap;
 	GetObject(hOldBitmap, sizeof(oldBitmap), (LPVOID)&oldBitmap);
 	
-	SDL_Surface *Result = SDL_CreateSurface(bitmap.bmWidth, bitmap.bmHeight, SDL_PIXELFORMAT_RGBA32);
-
-	LONG bytesPerPixel = bitmap.bmWidthBytes / bitmap.bmWidth;
-	for (LONG i = 0; i < bitmap.bmWidthBytes * bitmap.bmHeight; i += bytesPerPixel)
-	{
-		uint8* srcPixels = (uint8*)bitmap.bmBits;
-		uint8* dstPixels = (uint8*)Result->pixels;
-		dstPixels[i + 0] = srcPixels[i + 2];
-		dstPixels[i + 1] = srcPixels[i + 1];
-		dstPixels[i + 2] = srcPixels[i + 0];
-		dstPixels[i + 3] = srcPixels[i + 3];
+	SDL_Surface *Result = CreateLargeSurface(bitmap.bmWidth, bitmap.bmHeight, SDL_PIXELFORMAT_RGBA32, MemoryTag_Screenshot);
+	if (Result == NULL) {
+		// The rest of startup needs a screenshot, a heap surface only misses out on large pages.
+		LogWarning(
+			"Screenshot: Unable to map a %dx%d surface, using the heap",
+			(int)bitmap.bmWidth,
+			(int)bitmap.bmHeight);
+		Result = SDL_CreateSurface(bitmap.bmWidth, bitmap.bmHeight, SDL_PIXELFORMAT_RGBA32);
+	}
+	if (Result != NULL) {
+		// DIB sections with a positive height are bottom-up BGRA, swizzle and flip in one pass.
+		ConvertPixelsToRGBA32(
+			bitmap.bmBits,
+			bitmap.bmWidthBytes,
+			SDL_PIXELFORMAT_ARGB8888,
+			Result->pixels,
+			Result->pitch,
+			bitmap.bmWidth,
+			bitmap.bmHeight,
+			PixelConvertFlags_FlipVertical);
+	} else {
+		LogError("Screenshot: Unable to allocate a %dx%d surface", (int)bitmap.bmWidth, (int)bitmap.bmHeight);
 	}
-
-	SDL_FlipSurface(Result, SDL_FLIP_VERTICAL);
 
 	*OutSurface = Result;
 
+	DeleteObject(hBitmap);
 	DeleteDC(hMemoryDC);
 	ReleaseDC(NULL, hScreenDC);
-}
\ No newline at end of file
+
+	return Result != NULL;
+}
+
+
+// Live desktop needs damage tracking from the platform, the frozen screenshot is used instead.
+bool ApplicationBeginLiveDesktop(SDL_Surface* Screenshot, SDL_Window** OwnWindows, int OwnWindowCount)
+{
+	LogWarning("LiveDesktop: Not supported on this platform");
+	return false;
+}
+
+int ApplicationPollLiveDesktop(SDL_Rect* OutRects, int MaxRects)
+{
+	return 0;
+}
+
+void ApplicationEndLiveDesktop(void)
+{
+}
@@ -0,0 +1,123 @@
+#!/usr/bin/sh
+
+# Runs the desktop capture against Xvfb, once with MIT-SHM and once with the extension disabled to exercise the
+# XGetImage fallback. --profile-startup makes the screensaver exit after its first frame.
+
+target='screenshaver'
+platform='linux64'
+config='release'
+display=':99'
+screen='1920x1080x24'
+
+display_help()
+{
+	echo 'test_capture_xvfb.sh [-c|p|d|s|h]'
+	exit
+}
+
+while getopts 'c:p:d:s:h' flag; do
+	case "${flag}" in
+		h) display_help ;;
+		c) config="${OPTARG}" ;;
+		p) platform="${OPTARG}" ;;
+		d) display="${OPTARG}" ;;
+		s) screen="${OPTARG}" ;;
+		\?) exit 1 ;;
+	esac
+done
+
+binpath="./bin/${target}/bin/${platform}/${config}/${target}"
+
+if ! command -v Xvfb > /dev/null 2>&1; then
+	echo 'Xvfb not found, install it (xvfb / xorg-x11-server-Xvfb) to run the capture test'
+	exit 1
+fi
+
+if [ ! -x "$binpath" ]; then
+	echo "$binpath not found, build it first with ./build.sh -c $config -p $platform"
+	exit 1
+fi
+
+workdir="$(mktemp -d)"
+xvfbpid=''
+
+stop_xvfb()
+{
+	if [ -n "$xvfbpid" ]; then
+		kill "$xvfbpid" 2> /dev/null
+		wait "$xvfbpid" 2> /dev/null
+		xvfbpid=''
+	fi
+}
+
+cleanup()
+{
+	stop_xvfb
+	rm -rf "$workdir"
+}
+trap cleanup EXIT
+trap 'exit 1' INT TERM
+
+# run_case <name> <xvfb extra args> <expected log lines...>
+run_case()
+{
+	name="$1"
+	extra="$2"
+	shift 2
+
+	Xvfb "$display" -screen 0 "$screen" -nolisten tcp $extra > "$workdir/$name.xvfb.txt" 2>&1 &
+	xvfbpid=$!
+
+	# Wait for the server socket rather than a fixed delay.
+	socket="/tmp/.X11-unix/X${display#:}"
+	tries=0
+	while [ ! -S "$socket" ]; do
+		tries=$((tries + 1))
+		if [ $tries -gt 50 ] || ! kill -0 "$xvfbpid" 2> /dev/null; then
+			echo "$name: Xvfb did not start on $display"
+			cat "$workdir/$name.xvfb.txt"
+			stop_xvfb
+			return 1
+		fi
+		sleep 0.1
+	done
+
+	DISPLAY="$display" timeout 60 "$binpath" --profile-startup="$workdir/$name.json" > "$workdir/$name.log" 2>&1
+	status=$?
+	stop_xvfb
+
+	result=0
+	if [ $status -ne 0 ]; then
+		echo "$name: $target exited with status $status"
+		result=1
+	fi
+	for expected in "$@"; do
+		if ! grep -q -F "$expected" "$workdir/$name.log"; then
+			echo "$name: missing \"$expected\""
+			result=1
+		fi
+	done
+
+	if [ $result -ne 0 ]; then
+		cat "$workdir/$name.log"
+	else
+		grep -F 'Screenshot: Captured' "$workdir/$name.log" | sed "s/^/$name: /"
+	fi
+	return $result
+}
+
+failed=0
+
+run_case 'mit-shm' '' \
+	'via MIT-SHM' || failed=1
+
+run_case 'xgetimage' '-extension MIT-SHM' \
+	'MIT-SHM extension is unavailable' \
+	'Falling back to XGetImage' \
+	'via XGetImage' || failed=1
+
+if [ $failed -ne 0 ]; then
+	echo 'Capture test failed'
+	exit 1
+fi
+echo 'Capture test passed'
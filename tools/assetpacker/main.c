@@ -0,0 +1,297 @@
+// Builds the pre-decoded asset pack the runtime maps (see src/common/AssetPack.h) and benchmarks it against decoding
+// the source PNGs.
+//
+//   assetpacker pack <asset dir> <pack file>
+//   assetpacker bench <asset dir> <pack file> [iterations]
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SOKOL_IMPL
+#include <sokol_time.h>
+
+#define STB_DS_IMPLEMENTATION
+#include <stb_ds.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#if __LINUX__
+#define DIR_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#define DIR_WINDOWS
+#endif
+#define DIR_IMPLEMENTATION
+#include <dir.h>
+
+#include "AssetPack.h"
+#include "Log.h"
+
+typedef struct SourceImage {
+	char Path[512];
+	char Name[ASSET_PACK_NAME_LENGTH];
+} SourceImage;
+
+static int CompareSourceImages(const void* A, const void* B)
+{
+	return strcmp(((const SourceImage*)A)->Name, ((const SourceImage*)B)->Name);
+}
+
+static bool HasPngExtension(const char* Name)
+{
+	size_t Length = strlen(Name);
+	return Length > 4 && SDL_strcasecmp(Name + Length - 4, ".png") == 0;
+}
+
+// Sorted so the pack is byte for byte reproducible.
+static SourceImage* ListSourceImages(const char* AssetDir)
+{
+	SourceImage* Images = NULL;
+
+	dir_t* Dir = dir_open(AssetDir);
+	if (Dir == NULL) {
+		fprintf(stderr, "Unable to open '%s'\n", AssetDir);
+		return NULL;
+	}
+
+	for (dir_entry_t* Entry = dir_read(Dir); Entry != NULL; Entry = dir_read(Dir)) {
+		const char* Name = dir_name(Entry);
+		if (!dir_is_file(Entry) || !HasPngExtension(Name)) {
+			continue;
+		}
+		if (strlen(Name) >= ASSET_PACK_NAME_LENGTH) {
+			fprintf(stderr, "Skipping '%s', name longer than %d characters\n", Name, ASSET_PACK_NAME_LENGTH - 1);
+			continue;
+		}
+
+		SourceImage Image = {0};
+		snprintf(Image.Path, sizeof(Image.Path), "%s/%s", AssetDir, Name);
+		snprintf(Image.Name, sizeof(Image.Name), "%s", Name);
+		arrput(Images, Image);
+	}
+	dir_close(Dir);
+
+	if (arrlen(Images) > 0) {
+		qsort(Images, arrlen(Images), sizeof(SourceImage), CompareSourceImages);
+	}
+	return Images;
+}
+
+static uint64 AlignUp(uint64 Value, uint64 Alignment)
+{
+	return (Value + Alignment - 1) / Alignment * Alignment;
+}
+
+static bool WritePadding(FILE* File, uint64 Position, uint64 Target)
+{
+	static const uint8 Zeros[ASSET_PACK_DATA_ALIGNMENT] = {0};
+	while (Position < Target) {
+		uint64 Chunk = SDL_min(Target - Position, (uint64)sizeof(Zeros));
+		if (fwrite(Zeros, 1, Chunk, File) != Chunk) {
+			return false;
+		}
+		Position += Chunk;
+	}
+	return true;
+}
+
+static int Pack(const char* AssetDir, const char* PackFileName)
+{
+	SourceImage* Images = ListSourceImages(AssetDir);
+	if (arrlen(Images) == 0) {
+		fprintf(stderr, "No PNGs found in '%s'\n", AssetDir);
+		return 1;
+	}
+
+	int32 ImageCount = arrlen(Images);
+	AssetPackEntry* Entries = calloc(ImageCount, sizeof(AssetPackEntry));
+	stbi_uc** Pixels = calloc(ImageCount, sizeof(stbi_uc*));
+
+	uint64 IndexOffset = sizeof(AssetPackHeader);
+	uint64 Offset = AlignUp(IndexOffset + (uint64)ImageCount * sizeof(AssetPackEntry), ASSET_PACK_DATA_ALIGNMENT);
+
+	for (int32 Index = 0; Index < ImageCount; Index++) {
+		int Width, Height, Channels;
+		Pixels[Index] = stbi_load(Images[Index].Path, &Width, &Height, &Channels, 4);
+		if (Pixels[Index] == NULL) {
+			fprintf(stderr, "Unable to decode '%s': %s\n", Images[Index].Path, stbi_failure_reason());
+			return 1;
+		}
+
+		AssetPackEntry* Entry = &Entries[Index];
+		memcpy(Entry->Name, Images[Index].Name, sizeof(Entry->Name));
+		Entry->Width = (uint32)Width;
+		Entry->Height = (uint32)Height;
+		Entry->Pitch = (uint32)Width * 4;
+		Entry->Format = SDL_PIXELFORMAT_RGBA32;
+		Entry->Offset = Offset;
+		Entry->Bytes = (uint64)Entry->Pitch * Entry->Height;
+		Offset = AlignUp(Offset + Entry->Bytes, ASSET_PACK_DATA_ALIGNMENT);
+
+		printf("  %-32s %5dx%-5d %8" SDL_PRIu64 " bytes\n", Entry->Name, Width, Height, Entry->Bytes);
+	}
+
+	AssetPackHeader Header = {
+		.Magic = ASSET_PACK_MAGIC,
+		.Version = ASSET_PACK_VERSION,
+		.EntryCount = (uint32)ImageCount,
+		.EntryBytes = sizeof(AssetPackEntry),
+		.IndexOffset = IndexOffset,
+		.FileBytes = Offset,
+	};
+
+	FILE* File = fopen(PackFileName, "wb");
+	if (File == NULL) {
+		fprintf(stderr, "Unable to create '%s'\n", PackFileName);
+		return 1;
+	}
+
+	bool Written = fwrite(&Header, sizeof(Header), 1, File) == 1 &&
+				   fwrite(Entries, sizeof(AssetPackEntry), ImageCount, File) == (size_t)ImageCount;
+	uint64 Position = IndexOffset + (uint64)ImageCount * sizeof(AssetPackEntry);
+	for (int32 Index = 0; Written && Index < ImageCount; Index++) {
+		Written = WritePadding(File, Position, Entries[Index].Offset) &&
+				  fwrite(Pixels[Index], 1, Entries[Index].Bytes, File) == Entries[Index].Bytes;
+		Position = Entries[Index].Offset + Entries[Index].Bytes;
+	}
+	Written = Written && WritePadding(File, Position, Header.FileBytes);
+	Written = (fclose(File) == 0) && Written;
+
+	for (int32 Index = 0; Index < ImageCount; Index++) {
+		stbi_image_free(Pixels[Index]);
+	}
+	free(Pixels);
+	free(Entries);
+	arrfree(Images);
+
+	if (!Written) {
+		fprintf(stderr, "Failed writing '%s'\n", PackFileName);
+		remove(PackFileName);
+		return 1;
+	}
+
+	printf("Packed %d images into '%s' (%" SDL_PRIu64 " bytes)\n", ImageCount, PackFileName, Header.FileBytes);
+	return 0;
+}
+
+// Best effort eviction of a file from the page cache so the next read has to go to the device.
+static bool DropFromPageCache(const char* FileName)
+{
+#if __LINUX__
+	int File = open(FileName, O_RDONLY);
+	if (File < 0) {
+		return false;
+	}
+	fdatasync(File);
+	bool Dropped = posix_fadvise(File, 0, 0, POSIX_FADV_DONTNEED) == 0;
+	close(File);
+	return Dropped;
+#else
+	return false;
+#endif
+}
+
+static uint64 BenchPngDecode(const SourceImage* Images)
+{
+	uint64 StartTicks = stm_now();
+	for (int32 Index = 0; Index < arrlen(Images); Index++) {
+		size_t Bytes = 0;
+		void* Data = SDL_LoadFile(Images[Index].Path, &Bytes);
+		int Width, Height, Channels;
+		stbi_uc* Pixels = stbi_load_from_memory(Data, (int)Bytes, &Width, &Height, &Channels, 4);
+		stbi_image_free(Pixels);
+		SDL_free(Data);
+	}
+	return stm_since(StartTicks);
+}
+
+static uint64 BenchPackMap(const char* PackFileName, uint64* OutChecksum)
+{
+	uint64 StartTicks = stm_now();
+	AssetPack* Pack = AssetPackOpen(PackFileName);
+	for (int32 Index = 0; Index < AssetPackGetCount(Pack); Index++) {
+		const AssetPackEntry* Entry = AssetPackGetEntry(Pack, Index);
+		SDL_Surface* Surface = AssetPackCreateSurface(Pack, Entry->Name);
+
+		// Touch every page, the decode path produces all of its pixels so this keeps the comparison fair.
+		const uint8* Pixels = (const uint8*)Surface->pixels;
+		for (uint64 Offset = 0; Offset < Entry->Bytes; Offset += 4096) {
+			*OutChecksum += Pixels[Offset];
+		}
+		SDL_DestroySurface(Surface);
+	}
+	AssetPackClose(Pack);
+	return stm_since(StartTicks);
+}
+
+static int Bench(const char* AssetDir, const char* PackFileName, int Iterations)
+{
+	SourceImage* Images = ListSourceImages(AssetDir);
+	AssetPack* Probe = AssetPackOpen(PackFileName);
+	if (arrlen(Images) == 0 || Probe == NULL) {
+		fprintf(stderr, "Need PNGs in '%s' and a valid pack at '%s'\n", AssetDir, PackFileName);
+		return 1;
+	}
+	AssetPackClose(Probe);
+	LoggingSetLogLevel(LogLevel_Warning);
+
+	uint64 Checksum = 0;
+	uint64 PngWarm = 0, PackWarm = 0, PngCold = 0, PackCold = 0;
+	bool ColdSupported = true;
+
+	// One untimed pass so the warm numbers really are warm.
+	BenchPngDecode(Images);
+	BenchPackMap(PackFileName, &Checksum);
+
+	for (int Iteration = 0; Iteration < Iterations; Iteration++) {
+		PngWarm += BenchPngDecode(Images);
+		PackWarm += BenchPackMap(PackFileName, &Checksum);
+
+		for (int32 Index = 0; Index < arrlen(Images); Index++) {
+			ColdSupported &= DropFromPageCache(Images[Index].Path);
+		}
+		PngCold += BenchPngDecode(Images);
+
+		ColdSupported &= DropFromPageCache(PackFileName);
+		PackCold += BenchPackMap(PackFileName, &Checksum);
+	}
+
+	printf("%d images, %d iterations (checksum %" SDL_PRIu64 ")\n", (int)arrlen(Images), Iterations, Checksum);
+	printf("  warm  png decode %8.3f ms   pack map %8.3f ms\n", stm_ms(PngWarm) / Iterations, stm_ms(PackWarm) / Iterations);
+	if (ColdSupported) {
+		printf("  cold  png decode %8.3f ms   pack map %8.3f ms\n", stm_ms(PngCold) / Iterations, stm_ms(PackCold) / Iterations);
+	} else {
+		printf("  cold  unavailable, page cache eviction needs posix_fadvise\n");
+	}
+
+	arrfree(Images);
+	return 0;
+}
+
+static void PrintUsage(void)
+{
+	printf("usage: assetpacker pack <asset dir> <pack file>\n");
+	printf("       assetpacker bench <asset dir> <pack file> [iterations]\n");
+}
+
+int main(int argc, char* argv[])
+{
+	stm_setup();
+	LoggingInitialize(LogLevel_Info);
+
+	int Result = 1;
+	if (argc >= 4 && strcmp(argv[1], "pack") == 0) {
+		Result = Pack(argv[2], argv[3]);
+	} else if (argc >= 4 && strcmp(argv[1], "bench") == 0) {
+		Result = Bench(argv[2], argv[3], (argc >= 5) ? SDL_max(atoi(argv[4]), 1) : 10);
+	} else {
+		PrintUsage();
+	}
+
+	LoggingShutdown();
+	return Result;
+}
@@ -0,0 +1,253 @@
+// Turns the log.bin written by LOGGING_BINARY builds (see src/common/Log.h) back into the text the terminal would have
+// shown.
+//
+//   logdecode <log file> [--timestamps] [--sites]
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STB_DS_IMPLEMENTATION
+#include <stb_ds.h>
+
+#include "Log.h"
+
+// Ids are handed out from 1, one per call site in the binary. Anything past this is corruption, not a real program.
+#define LOGDECODE_MAX_CALLSITE_ID (1 << 20)
+
+typedef struct DecodedCallsite {
+	char* Format;
+	char* File;
+	int32 Line;
+	LogLevel Level;
+	bool Valid;
+} DecodedCallsite;
+
+typedef struct LogReader {
+	const uint8* Data;
+	size_t Length;
+	size_t Offset;
+	bool Failed;
+} LogReader;
+
+static void Read(LogReader* Reader, void* Out, size_t Size)
+{
+	if (Reader->Failed || Reader->Length - Reader->Offset < Size) {
+		Reader->Failed = true;
+		SDL_memset(Out, 0, Size);
+		return;
+	}
+	SDL_memcpy(Out, Reader->Data + Reader->Offset, Size);
+	Reader->Offset += Size;
+}
+
+// clang-format off
+#define DEFINE_LOG_READ(T, Name) \
+	static T CAT(Read, Name)(LogReader* Reader) \
+	{ \
+		T Value; \
+		Read(Reader, &Value, sizeof(Value)); \
+		return Value; \
+	}
+DEFINE_LOG_READ(uint8, U8)
+DEFINE_LOG_READ(uint16, U16)
+DEFINE_LOG_READ(uint32, U32)
+DEFINE_LOG_READ(uint64, U64)
+#undef DEFINE_LOG_READ
+// clang-format on
+
+// Copies a length-prefixed string into Scratch, NUL-terminated, and advances Scratch past it. A string that doesn't fit
+// before ScratchEnd can't come from a real record and fails the reader.
+static char* ReadString(LogReader* Reader, char** Scratch, const char* ScratchEnd)
+{
+	uint16 Length = ReadU16(Reader);
+	char* String = *Scratch;
+	if (!Reader->Failed && Length >= ScratchEnd - String) {
+		fprintf(stderr, "logdecode: %u byte string at offset %zu is longer than any record\n", Length, Reader->Offset);
+		Reader->Failed = true;
+	}
+	if (Reader->Failed) {
+		// Scratch may already be full, the caller drops the record anyway.
+		static char Empty[1];
+		return Empty;
+	}
+	Read(Reader, String, Length);
+	String[Reader->Failed ? 0 : Length] = '\0';
+	*Scratch += Length + 1;
+	return String;
+}
+
+static LogLevel ReadLevel(LogReader* Reader)
+{
+	uint8 Level = ReadU8(Reader);
+	return VALID_INDEX(Level, LogLevel_Count) ? (LogLevel)Level : LogLevel_None;
+}
+
+static void PrintLine(LogLevel Level, uint64 Timestamp, uint64 FirstTimestamp, bool Timestamps, const char* Text)
+{
+	if (Timestamps) {
+		printf("[%12.6f] ", (float64)(Timestamp - FirstTimestamp) / SDL_NS_PER_SECOND);
+	}
+	printf("[%s] %s", LogLevelNames[Level], Text);
+}
+
+static int Decode(const char* FileName, bool Timestamps, bool Sites)
+{
+	size_t FileSize = 0;
+	uint8* FileData = SDL_LoadFile(FileName, &FileSize);
+	if (!FileData) {
+		fprintf(stderr, "logdecode: can't read %s: %s\n", FileName, SDL_GetError());
+		return 1;
+	}
+
+	LogReader Reader = {FileData, FileSize, 0, false};
+	LogBinaryHeader Header;
+	Read(&Reader, &Header, sizeof(Header));
+	if (Reader.Failed || SDL_memcmp(Header.Magic, LOG_BINARY_MAGIC, sizeof(Header.Magic)) != 0) {
+		fprintf(stderr, "logdecode: %s is not a binary log\n", FileName);
+		SDL_free(FileData);
+		return 1;
+	}
+	if (Header.Version != LOG_BINARY_VERSION) {
+		fprintf(stderr, "logdecode: %s is version %u, expected %d\n", FileName, Header.Version, LOG_BINARY_VERSION);
+		SDL_free(FileData);
+		return 1;
+	}
+
+	DecodedCallsite* Callsites = NULL;
+	uint64 FirstTimestamp = 0;
+	bool HaveTimestamp = false;
+	int32 Records = 0;
+	int32 Unknown = 0;
+
+	// Records are never larger than the ring slot they were encoded into, so neither are their strings.
+	char ScratchData[2048];
+	char Text[2048];
+
+	while (Reader.Offset < Reader.Length && !Reader.Failed) {
+		size_t RecordOffset = Reader.Offset;
+		char* Scratch = ScratchData;
+		const char* ScratchEnd = ScratchData + sizeof(ScratchData);
+		uint8 Kind = ReadU8(&Reader);
+		switch (Kind) {
+			case LogRecordKind_Callsite: {
+				uint32 Id = ReadU32(&Reader);
+				LogLevel Level = ReadLevel(&Reader);
+				int32 Line = (int32)ReadU32(&Reader);
+				char* File = ReadString(&Reader, &Scratch, ScratchEnd);
+				char* Format = ReadString(&Reader, &Scratch, ScratchEnd);
+				if (Reader.Failed) {
+					break;
+				}
+				if (Id > LOGDECODE_MAX_CALLSITE_ID) {
+					fprintf(stderr, "logdecode: call site id %u at offset %zu is out of range\n", Id, RecordOffset);
+					Reader.Failed = true;
+					break;
+				}
+				while (arrlen(Callsites) <= Id) {
+					arrput(Callsites, (DecodedCallsite){0});
+				}
+				Callsites[Id] = (DecodedCallsite){SDL_strdup(Format), SDL_strdup(File), Line, Level, true};
+			} break;
+			case LogRecordKind_Message: {
+				uint32 Id = ReadU32(&Reader);
+				uint64 Timestamp = ReadU64(&Reader);
+				int32 ArgCount = ReadU8(&Reader);
+				LogArg Args[256];
+				for (int32 Index = 0; Index < ArgCount; Index++) {
+					Args[Index].Type = ReadU8(&Reader);
+					if (Args[Index].Type == LogArgType_String) {
+						Args[Index].String = ReadString(&Reader, &Scratch, ScratchEnd);
+					} else {
+						Args[Index].UInt = ReadU64(&Reader);
+					}
+				}
+				if (Reader.Failed) {
+					break;
+				}
+				if (!HaveTimestamp) {
+					FirstTimestamp = Timestamp;
+					HaveTimestamp = true;
+				}
+				if (Id >= (uint32)arrlen(Callsites) || !Callsites[Id].Valid) {
+					fprintf(stderr, "logdecode: message at offset %zu uses unknown call site %u\n", RecordOffset, Id);
+					Unknown++;
+					break;
+				}
+				DecodedCallsite* Site = &Callsites[Id];
+				LogFormatArgs(Text, sizeof(Text), Site->Format, Args, ArgCount);
+				PrintLine(Site->Level, Timestamp, FirstTimestamp, Timestamps, Text);
+				if (Sites) {
+					printf("  (%s:%d)", Site->File, Site->Line);
+				}
+				printf("\n");
+			} break;
+			case LogRecordKind_Text: {
+				LogLevel Level = ReadLevel(&Reader);
+				uint64 Timestamp = ReadU64(&Reader);
+				char* Message = ReadString(&Reader, &Scratch, ScratchEnd);
+				if (Reader.Failed) {
+					break;
+				}
+				if (!HaveTimestamp) {
+					FirstTimestamp = Timestamp;
+					HaveTimestamp = true;
+				}
+				PrintLine(Level, Timestamp, FirstTimestamp, Timestamps, Message);
+				printf("\n");
+			} break;
+			default:
+				fprintf(stderr, "logdecode: unknown record kind %u at offset %zu\n", Kind, RecordOffset);
+				Reader.Failed = true;
+				break;
+		}
+		Records++;
+	}
+
+	if (Reader.Failed) {
+		// A log cut short by a crash ends in a partial record, everything before it is still good. So does a corrupt one,
+		// decoding stops at the first record that can't be real.
+		fprintf(stderr, "logdecode: stopped at offset %zu of %zu\n", Reader.Offset, Reader.Length);
+	}
+	fprintf(stderr, "logdecode: %d records, %d call sites", Records, (int)arrlen(Callsites));
+	if (Unknown > 0) {
+		fprintf(stderr, ", %d messages with unknown call sites", Unknown);
+	}
+	fprintf(stderr, "\n");
+
+	for (int32 Index = 0; Index < arrlen(Callsites); Index++) {
+		SDL_free(Callsites[Index].Format);
+		SDL_free(Callsites[Index].File);
+	}
+	arrfree(Callsites);
+	SDL_free(FileData);
+	return 0;
+}
+
+static void PrintUsage(void)
+{
+	printf("usage: logdecode <log file> [--timestamps] [--sites]\n");
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2) {
+		PrintUsage();
+		return 1;
+	}
+
+	bool Timestamps = false;
+	bool Sites = false;
+	for (int ArgIndex = 2; ArgIndex < argc; ArgIndex++) {
+		if (strcmp(argv[ArgIndex], "--timestamps") == 0) {
+			Timestamps = true;
+		} else if (strcmp(argv[ArgIndex], "--sites") == 0) {
+			Sites = true;
+		} else {
+			PrintUsage();
+			return 1;
+		}
+	}
+	return Decode(argv[1], Timestamps, Sites);
+}
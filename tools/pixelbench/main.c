@@ -0,0 +1,191 @@
+// Measures full screen pixel buffer throughput on surfaces from CreateLargeSurface (see src/common/LargeAlloc.h) with
+// small pages against huge pages: first touch, fill, whole surface copy, and a blade wide band copied row by row the
+// way shaved texture uploads walk the surface, which is where TLB misses hurt most.
+//
+//   pixelbench [width height] [iterations]
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SOKOL_IMPL
+#include <sokol_time.h>
+
+#include "LargeAlloc.h"
+#include "Log.h"
+
+// Roughly a razor blade, narrow enough that every row of the band lands on a different small page.
+#define BENCH_BAND_WIDTH 128
+// Modes alternate, so drift in the machine's state (clocks, other load) hits both alike.
+#define BENCH_ROUNDS 2
+
+// Summed over every round.
+typedef struct BenchResult {
+	uint64 FirstTouch;
+	uint64 Fill;
+	uint64 Copy;
+	uint64 BandCopy;
+	int64 HugeBytes; // Backed by huge pages in the last round as the kernel reports it, -1 when unknown
+} BenchResult;
+
+// MemoryTracker.c calls it on initialization failures, tools have no platform main to provide it.
+SDL_NORETURN void PanicAndAbort(const char* Title, const char* Message)
+{
+	fprintf(stderr, "%s: %s\n", Title, Message);
+	abort();
+}
+
+// Sums AnonHugePages over the mappings holding any of the surfaces' pixels. Neighbouring blocks with the same advice
+// get merged into one mapping, each mapping is only counted once.
+static int64 QueryHugeBytes(SDL_Surface* const* Surfaces, int32 SurfaceCount)
+{
+#if __LINUX__
+	FILE* File = fopen("/proc/self/smaps", "r");
+	if (File == NULL) {
+		return -1;
+	}
+
+	bool Overlaps = false;
+	int64 HugeBytes = 0;
+	char Line[512];
+	while (fgets(Line, sizeof(Line), File) != NULL) {
+		unsigned long MappingStart, MappingEnd;
+		long long Kilobytes;
+		if (sscanf(Line, "%lx-%lx ", &MappingStart, &MappingEnd) == 2) {
+			Overlaps = false;
+			for (int32 Index = 0; Index < SurfaceCount; Index++) {
+				uintptr_t Start = (uintptr_t)Surfaces[Index]->pixels;
+				uintptr_t End = Start + (size_t)Surfaces[Index]->pitch * Surfaces[Index]->h;
+				Overlaps |= MappingStart < End && MappingEnd > Start;
+			}
+		} else if (Overlaps && sscanf(Line, "AnonHugePages: %lld kB", &Kilobytes) == 1) {
+			HugeBytes += Kilobytes * 1024;
+		}
+	}
+	fclose(File);
+	return HugeBytes;
+#else
+	return -1;
+#endif
+}
+
+static void BenchBandCopy(const SDL_Surface* Source, SDL_Surface* Dest)
+{
+	int32 BandBytes = BENCH_BAND_WIDTH * 4;
+	for (int32 X = 0; X + BENCH_BAND_WIDTH <= Source->w; X += BENCH_BAND_WIDTH) {
+		const uint8* SourceRow = (const uint8*)Source->pixels + X * 4;
+		uint8* DestRow = (uint8*)Dest->pixels + X * 4;
+		for (int32 Row = 0; Row < Source->h; Row++) {
+			memcpy(DestRow, SourceRow, BandBytes);
+			SourceRow += Source->pitch;
+			DestRow += Dest->pitch;
+		}
+	}
+}
+
+static bool Bench(int32 Width, int32 Height, int32 Iterations, bool HugePages, BenchResult* Result)
+{
+	LargeAllocEnableHugePages(HugePages);
+	SDL_Surface* Source = CreateLargeSurface(Width, Height, SDL_PIXELFORMAT_RGBA32, MemoryTag_Untagged);
+	SDL_Surface* Dest = CreateLargeSurface(Width, Height, SDL_PIXELFORMAT_RGBA32, MemoryTag_Untagged);
+	if (Source == NULL || Dest == NULL) {
+		fprintf(stderr, "Unable to create %dx%d surfaces\n", Width, Height);
+		SDL_DestroySurface(Source);
+		SDL_DestroySurface(Dest);
+		return false;
+	}
+	SDL_SetSurfaceBlendMode(Source, SDL_BLENDMODE_NONE);
+
+	// Faulting the pages in is its own cost, paid once per buffer when a display is created.
+	uint64 StartTicks = stm_now();
+	SDL_FillSurfaceRect(Source, NULL, 0xFF336699);
+	SDL_FillSurfaceRect(Dest, NULL, 0);
+	Result->FirstTouch += stm_since(StartTicks);
+
+	for (int32 Iteration = 0; Iteration < Iterations; Iteration++) {
+		StartTicks = stm_now();
+		SDL_FillSurfaceRect(Dest, NULL, 0xFF000000 | Iteration);
+		Result->Fill += stm_since(StartTicks);
+
+		StartTicks = stm_now();
+		SDL_BlitSurface(Source, NULL, Dest, NULL);
+		Result->Copy += stm_since(StartTicks);
+
+		StartTicks = stm_now();
+		BenchBandCopy(Source, Dest);
+		Result->BandCopy += stm_since(StartTicks);
+	}
+
+	Result->HugeBytes = QueryHugeBytes((SDL_Surface*[]){Source, Dest}, 2);
+	SDL_DestroySurface(Source);
+	SDL_DestroySurface(Dest);
+	return true;
+}
+
+static void PrintResult(const char* Name, const BenchResult* Result, int32 Iterations, double SurfaceBytes)
+{
+	double FillMS = stm_ms(Result->Fill) / (Iterations * BENCH_ROUNDS);
+	double CopyMS = stm_ms(Result->Copy) / (Iterations * BENCH_ROUNDS);
+	double BandMS = stm_ms(Result->BandCopy) / (Iterations * BENCH_ROUNDS);
+	double GB = SurfaceBytes / (1024.0 * 1024.0 * 1024.0);
+	printf(
+		"  %-11s first touch %7.2f ms  fill %6.2f ms %5.1f GB/s  copy %6.2f ms %5.1f GB/s  band %6.2f ms %5.1f GB/s",
+		Name,
+		stm_ms(Result->FirstTouch) / BENCH_ROUNDS,
+		FillMS,
+		GB / (FillMS / 1000.0),
+		CopyMS,
+		GB / (CopyMS / 1000.0),
+		BandMS,
+		GB / (BandMS / 1000.0));
+	if (Result->HugeBytes >= 0) {
+		size_t MappedBytes = LargeAllocGetMappedSize((size_t)SurfaceBytes) * 2;
+		printf("  huge pages back %d of %d MB", (int)(Result->HugeBytes >> 20), (int)(MappedBytes >> 20));
+	}
+	printf("\n");
+}
+
+static void PrintUsage(void)
+{
+	printf("usage: pixelbench [width height] [iterations]\n");
+}
+
+int main(int argc, char* argv[])
+{
+	int32 Width = 3840;
+	int32 Height = 2160;
+	int32 Iterations = 50;
+	if (argc == 2 || argc > 4) {
+		PrintUsage();
+		return 1;
+	}
+	if (argc >= 3) {
+		Width = SDL_max(atoi(argv[1]), BENCH_BAND_WIDTH);
+		Height = SDL_max(atoi(argv[2]), 1);
+	}
+	if (argc == 4) {
+		Iterations = SDL_max(atoi(argv[3]), 1);
+	}
+
+	stm_setup();
+	LoggingInitialize(LogLevel_Info);
+	LargeAllocInitialize();
+	LoggingFlush();
+
+	double SurfaceBytes = (double)Width * Height * 4;
+	printf("%dx%d RGBA32 (%.1f MB per surface), %d iterations\n", Width, Height, SurfaceBytes / (1024 * 1024), Iterations);
+
+	BenchResult Small = {0}, Huge = {0};
+	bool Succeeded = true;
+	for (int32 Round = 0; Succeeded && Round < BENCH_ROUNDS; Round++) {
+		Succeeded = Bench(Width, Height, Iterations, false, &Small) && Bench(Width, Height, Iterations, true, &Huge);
+	}
+	if (Succeeded) {
+		PrintResult("small pages", &Small, Iterations, SurfaceBytes);
+		PrintResult("huge pages", &Huge, Iterations, SurfaceBytes);
+	}
+
+	LoggingShutdown();
+	return Succeeded ? 0 : 1;
+}
@@ -0,0 +1,501 @@
+// Checks the scalar PixelConvert kernel against ground truth (SDL_ConvertPixels, hand computed box averages and an
+// index/expand round trip), then every other kernel the CPU supports against scalar byte for byte, then times each of
+// them on full screen sized work. Conversions cover all six source formats with and without flipping, and widths either
+// side of every vector width so the scalar tails get exercised. Exits nonzero on any mismatch.
+//
+//   pixelconverttest [width height] [iterations]
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SOKOL_IMPL
+#include <sokol_time.h>
+
+#include "PixelConvert.h"
+
+// Padding after every row, catches kernels that write past the row.
+#define TEST_PITCH_PADDING 20
+#define TEST_GUARD_BYTE 0xCD
+#define TEST_HEIGHT 5
+
+static const SDL_PixelFormat TestFormats[] = {
+	SDL_PIXELFORMAT_ARGB8888,
+	SDL_PIXELFORMAT_XRGB8888,
+	SDL_PIXELFORMAT_BGRX8888,
+	SDL_PIXELFORMAT_XBGR8888,
+	SDL_PIXELFORMAT_ABGR8888,
+	SDL_PIXELFORMAT_RGB565,
+};
+
+// Around 4, 8, 16 and 32 pixel vectors, plus odd sizes that leave every possible tail length.
+static const int32 TestWidths[] = {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 23, 31, 32, 33, 47, 63, 64, 65, 97, 127, 129, 333};
+
+static const int32 TestPaletteSizes[] = {1, 2, 15, 16, 17, 255, 256};
+
+static uint32 RandomState = 0x9E3779B9;
+
+static uint8 RandomByte(void)
+{
+	// xorshift32, fixed seed so a failure reproduces.
+	RandomState ^= RandomState << 13;
+	RandomState ^= RandomState >> 17;
+	RandomState ^= RandomState << 5;
+	return (uint8)(RandomState >> 24);
+}
+
+static void FillRandom(uint8* Bytes, size_t Count)
+{
+	for (size_t Index = 0; Index < Count; Index++) {
+		Bytes[Index] = RandomByte();
+	}
+}
+
+// Kernels the CPU can't run fall back to scalar, comparing those would pass without testing anything.
+static bool SelectKernel(PixelConvertKernel Kernel)
+{
+	return PixelConvertSetKernel(Kernel) == Kernel;
+}
+
+static bool CheckRows(
+	const char* What,
+	PixelConvertKernel Kernel,
+	const char* Reference,
+	const uint8* Expected,
+	const uint8* Actual,
+	int32 Pitch,
+	int32 RowBytes,
+	int32 Height)
+{
+	for (int32 Row = 0; Row < Height; Row++) {
+		const uint8* ExpectedRow = Expected + Row * Pitch;
+		const uint8* ActualRow = Actual + Row * Pitch;
+		for (int32 Byte = 0; Byte < Pitch; Byte++) {
+			if (ExpectedRow[Byte] != ActualRow[Byte]) {
+				printf(
+					"  FAIL %s: %s differs from %s at row %d byte %d%s (0x%02X, expected 0x%02X)\n",
+					What,
+					PixelConvertGetKernelName(Kernel),
+					Reference,
+					Row,
+					Byte,
+					(Byte >= RowBytes) ? " past the row" : "",
+					ActualRow[Byte],
+					ExpectedRow[Byte]);
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static int32 TestConvert(PixelConvertKernel Kernel)
+{
+	int32 Failures = 0;
+	for (int32 FormatIndex = 0; FormatIndex < ARRAY_COUNT(TestFormats); FormatIndex++) {
+		SDL_PixelFormat Format = TestFormats[FormatIndex];
+		for (int32 WidthIndex = 0; WidthIndex < ARRAY_COUNT(TestWidths); WidthIndex++) {
+			for (uint32 Flags = 0; Flags <= PixelConvertFlags_FlipVertical; Flags++) {
+				int32 Width = TestWidths[WidthIndex];
+				int32 SourcePitch = Width * SDL_BYTESPERPIXEL(Format) + TEST_PITCH_PADDING;
+				int32 DestPitch = Width * 4 + TEST_PITCH_PADDING;
+				uint8* Source = SDL_malloc((size_t)SourcePitch * TEST_HEIGHT);
+				uint8* Expected = SDL_malloc((size_t)DestPitch * TEST_HEIGHT);
+				uint8* Actual = SDL_malloc((size_t)DestPitch * TEST_HEIGHT);
+				FillRandom(Source, (size_t)SourcePitch * TEST_HEIGHT);
+				SDL_memset(Expected, TEST_GUARD_BYTE, (size_t)DestPitch * TEST_HEIGHT);
+				SDL_memset(Actual, TEST_GUARD_BYTE, (size_t)DestPitch * TEST_HEIGHT);
+
+				SelectKernel(PixelConvertKernel_Scalar);
+				ConvertPixelsToRGBA32(Source, SourcePitch, Format, Expected, DestPitch, Width, TEST_HEIGHT, Flags);
+				SelectKernel(Kernel);
+				ConvertPixelsToRGBA32(Source, SourcePitch, Format, Actual, DestPitch, Width, TEST_HEIGHT, Flags);
+
+				char What[96];
+				SDL_snprintf(
+					What,
+					sizeof(What),
+					"convert %s width %d%s",
+					SDL_GetPixelFormatName(Format),
+					Width,
+					(Flags & PixelConvertFlags_FlipVertical) ? " flipped" : "");
+				Failures += !CheckRows(What, Kernel, "Scalar", Expected, Actual, DestPitch, Width * 4, TEST_HEIGHT);
+
+				SDL_free(Source);
+				SDL_free(Expected);
+				SDL_free(Actual);
+			}
+		}
+	}
+	return Failures;
+}
+
+static int32 TestDownsample(PixelConvertKernel Kernel)
+{
+	int32 Failures = 0;
+	for (int32 WidthIndex = 0; WidthIndex < ARRAY_COUNT(TestWidths); WidthIndex++) {
+		int32 DestWidth = TestWidths[WidthIndex];
+		// An odd trailing column and row in the source, which are left out.
+		int32 SourcePitch = (DestWidth * 2 + 1) * 4 + TEST_PITCH_PADDING;
+		int32 DestPitch = DestWidth * 4 + TEST_PITCH_PADDING;
+		uint8* Source = SDL_malloc((size_t)SourcePitch * (TEST_HEIGHT * 2 + 1));
+		uint8* Expected = SDL_malloc((size_t)DestPitch * TEST_HEIGHT);
+		uint8* Actual = SDL_malloc((size_t)DestPitch * TEST_HEIGHT);
+		FillRandom(Source, (size_t)SourcePitch * (TEST_HEIGHT * 2 + 1));
+		SDL_memset(Expected, TEST_GUARD_BYTE, (size_t)DestPitch * TEST_HEIGHT);
+		SDL_memset(Actual, TEST_GUARD_BYTE, (size_t)DestPitch * TEST_HEIGHT);
+
+		SelectKernel(PixelConvertKernel_Scalar);
+		DownsamplePixels2x2(Source, SourcePitch, Expected, DestPitch, DestWidth, TEST_HEIGHT);
+		SelectKernel(Kernel);
+		DownsamplePixels2x2(Source, SourcePitch, Actual, DestPitch, DestWidth, TEST_HEIGHT);
+
+		char What[64];
+		SDL_snprintf(What, sizeof(What), "downsample width %d", DestWidth);
+		Failures += !CheckRows(What, Kernel, "Scalar", Expected, Actual, DestPitch, DestWidth * 4, TEST_HEIGHT);
+
+		SDL_free(Source);
+		SDL_free(Expected);
+		SDL_free(Actual);
+	}
+	return Failures;
+}
+
+static int32 TestExpand(PixelConvertKernel Kernel)
+{
+	int32 Failures = 0;
+	uint32 Colors[256];
+	FillRandom((uint8*)Colors, sizeof(Colors));
+
+	for (int32 PaletteIndex = 0; PaletteIndex < ARRAY_COUNT(TestPaletteSizes); PaletteIndex++) {
+		PixelPalette Palette;
+		PixelPaletteInitialize(&Palette, Colors, TestPaletteSizes[PaletteIndex]);
+
+		for (int32 WidthIndex = 0; WidthIndex < ARRAY_COUNT(TestWidths); WidthIndex++) {
+			int32 Width = TestWidths[WidthIndex];
+			int32 DestBytes = Width * 4 + TEST_PITCH_PADDING;
+			uint8* Indices = SDL_malloc(Width);
+			uint8* Expected = SDL_malloc(DestBytes);
+			uint8* Actual = SDL_malloc(DestBytes);
+			for (int32 X = 0; X < Width; X++) {
+				Indices[X] = RandomByte() % Palette.Count;
+			}
+			SDL_memset(Expected, TEST_GUARD_BYTE, DestBytes);
+			SDL_memset(Actual, TEST_GUARD_BYTE, DestBytes);
+
+			SelectKernel(PixelConvertKernel_Scalar);
+			ExpandIndexedPixels(Indices, &Palette, Expected, Width);
+			SelectKernel(Kernel);
+			ExpandIndexedPixels(Indices, &Palette, Actual, Width);
+
+			char What[64];
+			SDL_snprintf(What, sizeof(What), "expand %d colours width %d", Palette.Count, Width);
+			Failures += !CheckRows(What, Kernel, "Scalar", Expected, Actual, DestBytes, Width * 4, 1);
+
+			SDL_free(Indices);
+			SDL_free(Expected);
+			SDL_free(Actual);
+		}
+	}
+	return Failures;
+}
+
+// SDL_ConvertPixels is the reference for what each source format means, it has no flip so rows are reversed by hand.
+static int32 TestConvertAgainstSDL(void)
+{
+	int32 Failures = 0;
+	for (int32 FormatIndex = 0; FormatIndex < ARRAY_COUNT(TestFormats); FormatIndex++) {
+		SDL_PixelFormat Format = TestFormats[FormatIndex];
+		for (int32 WidthIndex = 0; WidthIndex < ARRAY_COUNT(TestWidths); WidthIndex++) {
+			for (uint32 Flags = 0; Flags <= PixelConvertFlags_FlipVertical; Flags++) {
+				int32 Width = TestWidths[WidthIndex];
+				int32 SourcePitch = Width * SDL_BYTESPERPIXEL(Format) + TEST_PITCH_PADDING;
+				int32 DestPitch = Width * 4 + TEST_PITCH_PADDING;
+				uint8* Source = SDL_malloc((size_t)SourcePitch * TEST_HEIGHT);
+				uint8* Converted = SDL_malloc((size_t)DestPitch * TEST_HEIGHT);
+				uint8* Expected = SDL_malloc((size_t)DestPitch * TEST_HEIGHT);
+				uint8* Actual = SDL_malloc((size_t)DestPitch * TEST_HEIGHT);
+				FillRandom(Source, (size_t)SourcePitch * TEST_HEIGHT);
+				SDL_memset(Expected, TEST_GUARD_BYTE, (size_t)DestPitch * TEST_HEIGHT);
+				SDL_memset(Actual, TEST_GUARD_BYTE, (size_t)DestPitch * TEST_HEIGHT);
+
+				bool Converts = SDL_ConvertPixels(
+					Width,
+					TEST_HEIGHT,
+					Format,
+					Source,
+					SourcePitch,
+					SDL_PIXELFORMAT_RGBA32,
+					Converted,
+					DestPitch);
+				for (int32 Row = 0; Converts && Row < TEST_HEIGHT; Row++) {
+					int32 SourceRow = (Flags & PixelConvertFlags_FlipVertical) ? TEST_HEIGHT - 1 - Row : Row;
+					SDL_memcpy(Expected + Row * DestPitch, Converted + SourceRow * DestPitch, Width * 4);
+				}
+				ConvertPixelsToRGBA32(Source, SourcePitch, Format, Actual, DestPitch, Width, TEST_HEIGHT, Flags);
+
+				// SDL rounds 5 and 6 bit channels as V * 255 / 31 (or 63) where we replicate the top bits, the two
+				// agree at both ends and are never more than one apart.
+				for (int32 Row = 0; Format == SDL_PIXELFORMAT_RGB565 && Row < TEST_HEIGHT; Row++) {
+					for (int32 Byte = Row * DestPitch; Byte < Row * DestPitch + Width * 4; Byte++) {
+						Expected[Byte] = (SDL_abs(Expected[Byte] - Actual[Byte]) <= 1) ? Actual[Byte] : Expected[Byte];
+					}
+				}
+
+				char What[96];
+				SDL_snprintf(
+					What,
+					sizeof(What),
+					"convert %s width %d%s",
+					SDL_GetPixelFormatName(Format),
+					Width,
+					(Flags & PixelConvertFlags_FlipVertical) ? " flipped" : "");
+				if (!Converts) {
+					printf("  FAIL %s: SDL_ConvertPixels failed, %s\n", What, SDL_GetError());
+					Failures++;
+				} else {
+					Failures += !CheckRows(
+						What,
+						PixelConvertKernel_Scalar,
+						"SDL_ConvertPixels",
+						Expected,
+						Actual,
+						DestPitch,
+						Width * 4,
+						TEST_HEIGHT);
+				}
+
+				SDL_free(Source);
+				SDL_free(Converted);
+				SDL_free(Expected);
+				SDL_free(Actual);
+			}
+		}
+	}
+	return Failures;
+}
+
+// Hand computed (A + B + C + D + 2) / 4 per channel, covering both rounding directions, halves rounding up and the
+// extremes. The odd trailing column and row hold junk that must not leak into the result.
+static int32 TestDownsampleKnownValues(void)
+{
+	static const uint8 Source[3][5][4] = {
+		{{0, 255, 0, 0}, {0, 255, 0, 0}, {10, 0, 1, 254}, {20, 255, 2, 255}, {0x77, 0x77, 0x77, 0x77}},
+		{{0, 255, 0, 0}, {0, 255, 2, 1}, {30, 0, 3, 255}, {40, 255, 3, 255}, {0x77, 0x77, 0x77, 0x77}},
+		{[0 ... 4] = {0x77, 0x77, 0x77, 0x77}},
+	};
+	static const uint8 Known[2][4] = {{0, 255, 1, 0}, {25, 128, 2, 255}};
+	uint8 Expected[sizeof(Known) + TEST_PITCH_PADDING];
+	uint8 Actual[sizeof(Known) + TEST_PITCH_PADDING];
+	SDL_memset(Expected, TEST_GUARD_BYTE, sizeof(Expected));
+	SDL_memset(Actual, TEST_GUARD_BYTE, sizeof(Actual));
+	SDL_memcpy(Expected, Known, sizeof(Known));
+
+	DownsamplePixels2x2(Source, sizeof(Source[0]), Actual, sizeof(Actual), 2, 1);
+	return !CheckRows(
+		"downsample known values",
+		PixelConvertKernel_Scalar,
+		"the known averages",
+		Expected,
+		Actual,
+		sizeof(Actual),
+		sizeof(Known),
+		1);
+}
+
+// IndexPixels then ExpandIndexedPixels has to give back the source image, and more than 256 colours can't be indexed.
+static int32 TestIndexRoundTrip(void)
+{
+	static const int32 ColorCounts[] = {1, 16, 17, 256, 257};
+
+	int32 Failures = 0;
+	for (int32 CountIndex = 0; CountIndex < ARRAY_COUNT(ColorCounts); CountIndex++) {
+		int32 ColorCount = ColorCounts[CountIndex];
+		int32 Width = TestWidths[ARRAY_COUNT(TestWidths) - 1];
+		int32 Pitch = Width * 4 + TEST_PITCH_PADDING;
+		uint8* Source = SDL_malloc((size_t)Pitch * TEST_HEIGHT);
+		uint8* Indices = SDL_malloc((size_t)Width * TEST_HEIGHT);
+		uint8* Expanded = SDL_malloc((size_t)Pitch * TEST_HEIGHT);
+		uint32 Colors[256];
+		FillRandom(Source, (size_t)Pitch * TEST_HEIGHT);
+		SDL_memset(Expanded, TEST_GUARD_BYTE, (size_t)Pitch * TEST_HEIGHT);
+
+		// Multiplying by an odd constant keeps the colours distinct. Each one appears in order first so the palette
+		// order is known, the rest of the image repeats them at random.
+		for (int32 Pixel = 0; Pixel < Width * TEST_HEIGHT; Pixel++) {
+			uint32 Color = (uint32)((Pixel < ColorCount) ? Pixel : RandomByte() % ColorCount) * 0x9E3779B1u;
+			SDL_memcpy(Source + (Pixel / Width) * Pitch + (Pixel % Width) * 4, &Color, 4);
+		}
+
+		char What[64];
+		SDL_snprintf(What, sizeof(What), "index %d colours", ColorCount);
+		int32 Indexed = IndexPixels(Source, Pitch, Width, TEST_HEIGHT, Indices, Colors);
+		int32 Expected = (ColorCount <= 256) ? ColorCount : -1;
+		if (Indexed != Expected) {
+			printf("  FAIL %s: IndexPixels returned %d, expected %d\n", What, Indexed, Expected);
+			Failures++;
+		} else if (Indexed > 0) {
+			for (int32 Color = 0; Color < Indexed; Color++) {
+				if (Colors[Color] != (uint32)Color * 0x9E3779B1u) {
+					printf("  FAIL %s: colour %d out of order\n", What, Color);
+					Failures++;
+					break;
+				}
+			}
+
+			PixelPalette Palette;
+			PixelPaletteInitialize(&Palette, Colors, Indexed);
+			for (int32 Row = 0; Row < TEST_HEIGHT; Row++) {
+				ExpandIndexedPixels(Indices + Row * Width, &Palette, Expanded + Row * Pitch, Width);
+			}
+			// Only the rows are compared, the source padding is random.
+			for (int32 Row = 0; Row < TEST_HEIGHT; Row++) {
+				SDL_memset(Source + Row * Pitch + Width * 4, TEST_GUARD_BYTE, TEST_PITCH_PADDING);
+			}
+			Failures += !CheckRows(
+				What,
+				PixelConvertKernel_Scalar,
+				"the source image",
+				Source,
+				Expanded,
+				Pitch,
+				Width * 4,
+				TEST_HEIGHT);
+		}
+
+		SDL_free(Source);
+		SDL_free(Indices);
+		SDL_free(Expanded);
+	}
+	return Failures;
+}
+
+static void PrintTiming(const char* What, uint64 Ticks, int32 Iterations, double Bytes)
+{
+	double MS = stm_ms(Ticks) / Iterations;
+	printf("  %-28s %7.2f ms %6.2f GB/s\n", What, MS, Bytes / (1024.0 * 1024.0 * 1024.0) / (MS / 1000.0));
+}
+
+// Dest bytes written per second, the same measure for every operation.
+static void Bench(PixelConvertKernel Kernel, int32 Width, int32 Height, int32 Iterations)
+{
+	SelectKernel(Kernel);
+	printf("%s:\n", PixelConvertGetKernelName(Kernel));
+
+	int32 Pitch = Width * 4;
+	uint8* Source = SDL_malloc((size_t)Pitch * Height);
+	uint8* Dest = SDL_malloc((size_t)Pitch * Height);
+	FillRandom(Source, (size_t)Pitch * Height);
+	// Fault the pages in and warm the caches up front, otherwise the first timing pays for it.
+	SDL_memset(Dest, 0, (size_t)Pitch * Height);
+	ConvertPixelsToRGBA32(Source, Pitch, SDL_PIXELFORMAT_ARGB8888, Dest, Pitch, Width, Height, 0);
+	double DestBytes = (double)Pitch * Height;
+
+	for (int32 FormatIndex = 0; FormatIndex < ARRAY_COUNT(TestFormats); FormatIndex++) {
+		SDL_PixelFormat Format = TestFormats[FormatIndex];
+		int32 SourcePitch = Width * SDL_BYTESPERPIXEL(Format);
+		for (uint32 Flags = 0; Flags <= PixelConvertFlags_FlipVertical; Flags++) {
+			uint64 StartTicks = stm_now();
+			for (int32 Iteration = 0; Iteration < Iterations; Iteration++) {
+				ConvertPixelsToRGBA32(Source, SourcePitch, Format, Dest, Pitch, Width, Height, Flags);
+			}
+			char What[64];
+			SDL_snprintf(
+				What,
+				sizeof(What),
+				"%s%s",
+				SDL_GetPixelFormatName(Format) + SDL_strlen("SDL_PIXELFORMAT_"),
+				(Flags & PixelConvertFlags_FlipVertical) ? " flipped" : "");
+			PrintTiming(What, stm_since(StartTicks), Iterations, DestBytes);
+		}
+	}
+
+	uint64 StartTicks = stm_now();
+	for (int32 Iteration = 0; Iteration < Iterations; Iteration++) {
+		DownsamplePixels2x2(Source, Pitch, Dest, Pitch, Width / 2, Height / 2);
+	}
+	PrintTiming("downsample 2x2", stm_since(StartTicks), Iterations, DestBytes / 4);
+
+	// The shuffle path and the gather path.
+	static const int32 BenchPaletteSizes[] = {16, 256};
+	for (int32 PaletteIndex = 0; PaletteIndex < ARRAY_COUNT(BenchPaletteSizes); PaletteIndex++) {
+		int32 ColorCount = BenchPaletteSizes[PaletteIndex];
+		PixelPalette Palette;
+		PixelPaletteInitialize(&Palette, (const uint32*)Source, ColorCount);
+		// Indices go in the second half of Dest, they're a quarter the size of the pixels.
+		uint8* Indices = Dest + (size_t)Pitch * Height - (size_t)Width * Height;
+		for (size_t Index = 0; Index < (size_t)Width * Height; Index++) {
+			Indices[Index] = RandomByte() % ColorCount;
+		}
+		StartTicks = stm_now();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++) {
+			for (int32 Row = 0; Row < Height / 2; Row++) {
+				ExpandIndexedPixels(Indices + (size_t)Row * Width, &Palette, Dest + (size_t)Row * Pitch, Width);
+			}
+		}
+		char What[64];
+		SDL_snprintf(What, sizeof(What), "expand %d colours", ColorCount);
+		PrintTiming(What, stm_since(StartTicks), Iterations, DestBytes / 2);
+	}
+
+	SDL_free(Source);
+	SDL_free(Dest);
+}
+
+static void PrintUsage(void)
+{
+	printf("usage: pixelconverttest [width height] [iterations]\n");
+}
+
+int main(int argc, char* argv[])
+{
+	int32 Width = 3840;
+	int32 Height = 2160;
+	int32 Iterations = 20;
+	if (argc == 2 || argc > 4) {
+		PrintUsage();
+		return 1;
+	}
+	if (argc >= 3) {
+		Width = SDL_max(atoi(argv[1]), 2);
+		Height = SDL_max(atoi(argv[2]), 2);
+	}
+	if (argc == 4) {
+		Iterations = SDL_max(atoi(argv[3]), 1);
+	}
+
+	stm_setup();
+	printf("Auto selects %s\n", PixelConvertGetKernelName(PixelConvertGetKernel()));
+
+	// Scalar is the reference for the other kernels, so it is checked against ground truth first.
+	SelectKernel(PixelConvertKernel_Scalar);
+	int32 Failures = TestConvertAgainstSDL() + TestDownsampleKnownValues() + TestIndexRoundTrip();
+	printf("Scalar %s\n", (Failures == 0) ? "matches SDL_ConvertPixels and known values" : "FAILED");
+
+	PixelConvertKernel Tested[PixelConvertKernel_Count];
+	int32 TestedCount = 0;
+	for (PixelConvertKernel Kernel = PixelConvertKernel_Scalar; Kernel < PixelConvertKernel_Count; Kernel++) {
+		if (!SelectKernel(Kernel)) {
+			printf("%-6s skipped, not supported by this CPU\n", PixelConvertGetKernelName(Kernel));
+			continue;
+		}
+		Tested[TestedCount++] = Kernel;
+		if (Kernel == PixelConvertKernel_Scalar) {
+			continue;
+		}
+		int32 KernelFailures = TestConvert(Kernel) + TestDownsample(Kernel) + TestExpand(Kernel);
+		printf("%-6s %s\n", PixelConvertGetKernelName(Kernel), (KernelFailures == 0) ? "matches Scalar" : "FAILED");
+		Failures += KernelFailures;
+	}
+
+	printf("\n%dx%d, %d iterations, GB/s of destination pixels written\n", Width, Height, Iterations);
+	for (int32 Index = 0; Index < TestedCount; Index++) {
+		Bench(Tested[Index], Width, Height, Iterations);
+	}
+
+	if (Failures > 0) {
+		printf("\n%d mismatches\n", Failures);
+	}
+	return (Failures == 0) ? 0 : 1;
+}